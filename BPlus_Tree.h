@@ -0,0 +1,876 @@
+//   File: BPlus_Tree.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: B+ tree data structure declarations and definitions.
+//         Keys are packed into cache-line-aligned nodes so a lookup touches a
+//         handful of cache lines instead of one node per tree level.
+// ---------------------------------------------------------------------
+
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include "NodePool.h"
+#include "Key_Traits.h"
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename K, typename V, typename Compare = KeyCompare<K>>
+class BPlusTree {
+public:
+    // Keys per node, sized so a node's key block fills two cache lines
+    static constexpr int NODE_KEYS = (128 / sizeof(K) < 4) ? 4 : int(128 / sizeof(K));
+    static constexpr int MAX_HEIGHT = 32;
+
+private:
+    struct alignas(64) BPlusNode {
+        K keys[NODE_KEYS];
+        int count;      // Number of keys in use
+        bool isLeaf;
+
+        explicit BPlusNode(bool leaf) : count{0}, isLeaf{leaf} {}
+    };
+
+    // Internal node: children[i] holds keys in [keys[i-1], keys[i])
+    struct InternalNode : BPlusNode {
+        BPlusNode* children[NODE_KEYS + 1];
+
+        InternalNode() : BPlusNode(false), children{} {}
+    };
+
+    struct LeafNode : BPlusNode {
+        LeafNode* prevLeaf;
+        LeafNode* nextLeaf;
+        V values[NODE_KEYS];
+
+        LeafNode() : BPlusNode(true), prevLeaf{nullptr}, nextLeaf{nullptr} {}
+    };
+
+    // One step of a root-to-leaf descent
+    struct PathStep {
+        InternalNode* node;
+        int childIndex;
+    };
+
+    BPlusNode* treeRoot;
+    int _size;
+    NodePool<InternalNode> _internalPool;
+    NodePool<LeafNode> _leafPool;
+
+public:
+    // Bidirectional in-order iterator over the leaf chain. Dereferences to the value;
+    // key() gives the key. Inserting or removing keys invalidates iterators.
+    class iterator {
+        friend class BPlusTree;
+        BPlusTree* _tree;
+        LeafNode* _leaf;     // nullptr for end()
+        int _index;
+
+        iterator(BPlusTree* tree, LeafNode* leaf, int index) : _tree{tree}, _leaf{leaf}, _index{index} {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = V;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        iterator() : _tree{nullptr}, _leaf{nullptr}, _index{0} {}
+
+        const K & key() const { return _leaf->keys[_index]; }
+        V & value() const { return _leaf->values[_index]; }
+        V & operator*() const { return _leaf->values[_index]; }
+        V * operator->() const { return &_leaf->values[_index]; }
+
+        iterator & operator++() {
+            if (++_index == _leaf->count) {
+                _leaf = _leaf->nextLeaf;
+                _index = 0;
+            }
+            return *this;
+        }
+        iterator & operator--() {
+            if (!_leaf) {
+                // Stepping back from end() lands on the maximum key
+                _leaf = _tree->_lastLeaf();
+                _index = _leaf ? _leaf->count - 1 : 0;
+            } else if (_index > 0) {
+                --_index;
+            } else {
+                _leaf = _leaf->prevLeaf;
+                _index = _leaf ? _leaf->count - 1 : 0;
+            }
+            return *this;
+        }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        iterator operator--(int) { iterator old = *this; --*this; return old; }
+
+        bool operator==(const iterator & other) const { return _leaf == other._leaf and _index == other._index; }
+        bool operator!=(const iterator & other) const { return !(*this == other); }
+    };
+
+    // Constructors
+    BPlusTree();
+    ~BPlusTree();
+
+    // Tree Management Methods
+    void insert(const K & key, const V & value);
+    void insert(const K & key, V && value);
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K & key, Args &&... args);
+    template <typename... Args>
+    std::pair<V*, bool> emplace(const K & key, Args &&... args);
+    template <typename M>
+    std::pair<V*, bool> insert_or_assign(const K & key, M && value);
+    V& cursedInsert(const K & key); // Used in [] operator overloading
+    bool remove(const K & key);
+    V* findValue(const K & key);
+    int size();
+    void clear();
+
+    // Bulk Construction Methods
+    template <typename KeyIt, typename ValueIt>
+    void assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue);
+    template <typename KeyIt, typename ValueIt>
+    void assign(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue);
+
+    // Traversal Methods
+    template <typename Visitor>
+    void visitInOrder(Visitor visit);
+
+    // Iterator Methods
+    iterator begin();
+    iterator end();
+    iterator lower_bound(const K & key);
+    iterator upper_bound(const K & key);
+
+    // Range Query Methods
+    iterator floor(const K & key);
+    iterator ceil(const K & key);
+
+private:
+    // Tree Management Methods
+    LeafNode* _findLeaf(const K & key, PathStep* path, int & depth);
+    void _insertIntoParent(PathStep* path, int depth, const K & separator, BPlusNode* rightNode);
+    void _removeFromParent(PathStep* path, int depth);
+    void _destroySubtree(BPlusNode* node);
+    LeafNode* _firstLeaf();
+    LeafNode* _lastLeaf();
+    iterator _leafPosition(LeafNode* leaf, int position);
+
+    // Node Searches
+    static bool _less(const K & a, const K & b) { return Compare::compare(a, b) < 0; }
+    static int _childIndex(const BPlusNode* node, const K & key);
+    static int _lowerBound(const BPlusNode* node, const K & key);
+};
+
+
+// ---------------------------------------------------------------------
+//                          Constructors
+
+/**
+ * Default constructor
+ */
+template <typename K, typename V, typename Compare>
+BPlusTree<K,V,Compare>::BPlusTree() {
+    treeRoot = nullptr;
+    _size = 0;
+}
+
+
+/**
+ * Destructor
+ */
+template <typename K, typename V, typename Compare>
+BPlusTree<K,V,Compare>::~BPlusTree() {
+    clear();
+}
+
+
+// ---------------------------------------------------------------------
+//                  Public Tree Management Methods
+
+/**
+ * Adds a (key, value) pair to the tree, overwriting the value if the key exists.
+ * @param key - Key to determine placement in tree.
+ * @param value - Value to store at the key.
+ */
+template <typename K, typename V, typename Compare>
+void BPlusTree<K,V,Compare>::insert(const K & key, const V & value) {
+    cursedInsert(key) = value;
+}
+
+
+/**
+ * Adds a (key, value) pair to the tree, moving the value into place.
+ */
+template <typename K, typename V, typename Compare>
+void BPlusTree<K,V,Compare>::insert(const K & key, V && value) {
+    cursedInsert(key) = std::move(value);
+}
+
+
+/**
+ * Builds a value from the given arguments for a new key, unless the key exists.
+ * Leaves hold their values in fixed arrays, so the value is built once and
+ * moved into its slot rather than constructed there.
+ * @param key - Key to determine placement in tree.
+ * @param args - Arguments for V's constructor. Left untouched if the key exists.
+ * @return Returns the value at the key and whether it was inserted.
+ */
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<V*, bool> BPlusTree<K,V,Compare>::try_emplace(const K & key, Args &&... args) {
+    int sizeBefore = _size;
+    V & slot = cursedInsert(key);
+
+    if (_size == sizeBefore)
+        return {&slot, false};
+
+    slot = V(std::forward<Args>(args)...);
+    return {&slot, true};
+}
+
+
+/**
+ * Same as try_emplace(). The key is passed separately, so no value is built for an existing key.
+ */
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<V*, bool> BPlusTree<K,V,Compare>::emplace(const K & key, Args &&... args) {
+    return try_emplace(key, std::forward<Args>(args)...);
+}
+
+
+/**
+ * Assigns a value to a key, forwarding it into the key's slot, so an rvalue is moved exactly once.
+ * @return Returns the value at the key and whether the key was inserted.
+ */
+template <typename K, typename V, typename Compare>
+template <typename M>
+std::pair<V*, bool> BPlusTree<K,V,Compare>::insert_or_assign(const K & key, M && value) {
+    int sizeBefore = _size;
+    V & slot = cursedInsert(key);
+
+    slot = std::forward<M>(value);
+    return {&slot, _size != sizeBefore};
+}
+
+
+/**
+ * Insertion for CursedArray [] operation overloading.
+ * Returns the existing value for a key, or a default-constructed value in a new slot.
+ * Full nodes are split on the way back up the descent path.
+ * @param key Key/Index to determine placement in tree. Must be comparable.
+ * @return Returns a reference to the value stored at the key.
+ */
+template <typename K, typename V, typename Compare>
+V& BPlusTree<K,V,Compare>::cursedInsert(const K & key) {
+    if (!treeRoot) {
+        // First key to be inserted into the tree
+        LeafNode* newLeaf = _leafPool.create();
+        newLeaf->keys[0] = key;
+        newLeaf->count = 1;
+        treeRoot = newLeaf;
+        ++_size;
+        return newLeaf->values[0];
+    }
+
+    PathStep path[MAX_HEIGHT];
+    int depth = 0;
+    LeafNode* leaf = _findLeaf(key, path, depth);
+    int position = _lowerBound(leaf, key);
+
+    // Key is in the tree, return its value
+    if (position < leaf->count and Compare::compare(leaf->keys[position], key) == 0)
+        return leaf->values[position];
+
+    // Leaf is full, split it in half before inserting
+    if (leaf->count == NODE_KEYS) {
+        LeafNode* rightLeaf = _leafPool.create();
+        int half = NODE_KEYS / 2;
+
+        for (int i = half; i < NODE_KEYS; ++i) {
+            rightLeaf->keys[i - half] = leaf->keys[i];
+            rightLeaf->values[i - half] = std::move(leaf->values[i]);
+        }
+        rightLeaf->count = NODE_KEYS - half;
+        leaf->count = half;
+
+        rightLeaf->nextLeaf = leaf->nextLeaf;
+        rightLeaf->prevLeaf = leaf;
+        if (leaf->nextLeaf)
+            leaf->nextLeaf->prevLeaf = rightLeaf;
+        leaf->nextLeaf = rightLeaf;
+
+        _insertIntoParent(path, depth, rightLeaf->keys[0], rightLeaf);
+
+        if (position > half) {
+            leaf = rightLeaf;
+            position -= half;
+        }
+    }
+
+    // Shift larger keys right to open a slot
+    for (int i = leaf->count; i > position; --i) {
+        leaf->keys[i] = leaf->keys[i - 1];
+        leaf->values[i] = std::move(leaf->values[i - 1]);
+    }
+    leaf->keys[position] = key;
+    leaf->values[position] = V();
+    ++leaf->count;
+    ++_size;
+
+    return leaf->values[position];
+} // End cursedInsert()
+
+
+/**
+ * Finds the value stored at a key.
+ * @param key (K) - Key to find.
+ * @return - Returns a pointer to the value stored at a key, or nullptr if the key is not in the tree.
+ */
+template <typename K, typename V, typename Compare>
+V* BPlusTree<K,V,Compare>::findValue(const K & key) {
+    if (!treeRoot)
+        return nullptr;
+
+    BPlusNode* currentNode = treeRoot;
+    while (!currentNode->isLeaf)
+        currentNode = static_cast<InternalNode*>(currentNode)->children[_childIndex(currentNode, key)];
+
+    auto* leaf = static_cast<LeafNode*>(currentNode);
+    int position = _lowerBound(leaf, key);
+
+    if (position < leaf->count and Compare::compare(leaf->keys[position], key) == 0)
+        return &leaf->values[position];
+
+    return nullptr;
+
+} // End findValue()
+
+
+/**
+ * Removes a key from the tree.
+ * Leaves are freed once empty rather than merged with a sibling, which keeps
+ * removal local to a single root-to-leaf path.
+ * @param key - Key to be found and removed.
+ * @return - True if key existed within the tree, false if the key did not exist.
+ */
+template <typename K, typename V, typename Compare>
+bool BPlusTree<K,V,Compare>::remove(const K & key) {
+    if (!treeRoot)
+        return false;
+
+    PathStep path[MAX_HEIGHT];
+    int depth = 0;
+    LeafNode* leaf = _findLeaf(key, path, depth);
+    int position = _lowerBound(leaf, key);
+
+    if (position == leaf->count or Compare::compare(leaf->keys[position], key) != 0)
+        return false;
+
+    for (int i = position; i < leaf->count - 1; ++i) {
+        leaf->keys[i] = leaf->keys[i + 1];
+        leaf->values[i] = std::move(leaf->values[i + 1]);
+    }
+    --leaf->count;
+    --_size;
+
+    if (leaf->count > 0)
+        return true;
+
+    // Leaf is empty, unlink it from its siblings and its parent
+    if (leaf->prevLeaf)
+        leaf->prevLeaf->nextLeaf = leaf->nextLeaf;
+    if (leaf->nextLeaf)
+        leaf->nextLeaf->prevLeaf = leaf->prevLeaf;
+
+    _leafPool.destroy(leaf);
+    _removeFromParent(path, depth);
+
+    return true;
+} // End remove()
+
+
+/**
+ * @return Returns the number of keys in the tree.
+ */
+template <typename K, typename V, typename Compare>
+inline int BPlusTree<K,V,Compare>::size() {
+    return _size;
+}
+
+
+/**
+ * Removes every key from the tree and releases all node slabs.
+ */
+template <typename K, typename V, typename Compare>
+void BPlusTree<K,V,Compare>::clear() {
+    if (treeRoot and (!std::is_trivially_destructible<K>::value or !std::is_trivially_destructible<V>::value))
+        _destroySubtree(treeRoot);
+
+    _internalPool.releaseAll();
+    _leafPool.releaseAll();
+    treeRoot = nullptr;
+    _size = 0;
+}
+
+
+// ---------------------------------------------------------------------
+//                     Bulk Construction Methods
+
+/**
+ * Replaces the contents of the tree with a sorted range in O(n).
+ * Leaves are packed full and linked left to right, then each internal level is
+ * built over the one below it.
+ * @param firstKey, lastKey - Keys in strictly ascending order.
+ * @param firstValue - Start of the values matching each key. Wrap in std::make_move_iterator to move them.
+ */
+template <typename K, typename V, typename Compare>
+template <typename KeyIt, typename ValueIt>
+void BPlusTree<K,V,Compare>::assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue) {
+    clear();
+
+    // Smallest key and node of each subtree on the level being built
+    std::vector<K> levelKeys;
+    std::vector<BPlusNode*> levelNodes;
+    LeafNode* prevLeaf = nullptr;
+
+    while (firstKey != lastKey) {
+        LeafNode* leaf = _leafPool.create();
+
+        while (firstKey != lastKey and leaf->count < NODE_KEYS) {
+            leaf->keys[leaf->count] = *firstKey;
+            leaf->values[leaf->count] = *firstValue;
+            ++leaf->count;
+            ++firstKey;
+            ++firstValue;
+        }
+
+        leaf->prevLeaf = prevLeaf;
+        if (prevLeaf)
+            prevLeaf->nextLeaf = leaf;
+        prevLeaf = leaf;
+
+        _size += leaf->count;
+        levelKeys.push_back(leaf->keys[0]);
+        levelNodes.push_back(leaf);
+    }
+
+    // Group up to NODE_KEYS + 1 children under each parent until one node remains
+    while (levelNodes.size() > 1) {
+        std::vector<K> parentKeys;
+        std::vector<BPlusNode*> parentNodes;
+
+        for (size_t first = 0; first < levelNodes.size(); first += NODE_KEYS + 1) {
+            size_t last = std::min(first + NODE_KEYS + 1, levelNodes.size());
+            InternalNode* parent = _internalPool.create();
+
+            parent->children[0] = levelNodes[first];
+            for (size_t i = first + 1; i < last; ++i) {
+                parent->keys[parent->count] = levelKeys[i];
+                parent->children[++parent->count] = levelNodes[i];
+            }
+
+            parentKeys.push_back(levelKeys[first]);
+            parentNodes.push_back(parent);
+        }
+
+        levelKeys.swap(parentKeys);
+        levelNodes.swap(parentNodes);
+    }
+
+    treeRoot = levelNodes.empty() ? nullptr : levelNodes[0];
+
+} // End assignSorted()
+
+
+/**
+ * Replaces the contents of the tree with an unsorted range.
+ * Pairs are sorted by key first, so this runs in O(n log n). If a key repeats,
+ * the last value for it wins, as if each pair had been inserted in turn.
+ * @param firstKey, lastKey - Keys in any order.
+ * @param firstValue - Start of the values matching each key.
+ */
+template <typename K, typename V, typename Compare>
+template <typename KeyIt, typename ValueIt>
+void BPlusTree<K,V,Compare>::assign(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue) {
+    std::vector<K> keys(firstKey, lastKey);
+    std::vector<V> values;
+    values.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i, ++firstValue)
+        values.push_back(*firstValue);
+
+    std::vector<int> order(keys.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = int(i);
+
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return _less(keys[a], keys[b]); });
+
+    // Keep only the last of each run of equal keys
+    std::vector<K> sortedKeys;
+    std::vector<V> sortedValues;
+    sortedKeys.reserve(order.size());
+    sortedValues.reserve(order.size());
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 < order.size() and !_less(keys[order[i]], keys[order[i + 1]]))
+            continue;
+
+        sortedKeys.push_back(keys[order[i]]);
+        sortedValues.push_back(std::move(values[order[i]]));
+    }
+
+    assignSorted(sortedKeys.begin(), sortedKeys.end(), std::make_move_iterator(sortedValues.begin()));
+
+} // End assign()
+
+
+// ---------------------------------------------------------------------
+//                       Public Traversal Methods
+
+/**
+ * Visits every (key, value) pair in ascending key order by walking the leaf chain.
+ * @param visit - Called as visit(key, value).
+ */
+template <typename K, typename V, typename Compare>
+template <typename Visitor>
+void BPlusTree<K,V,Compare>::visitInOrder(Visitor visit) {
+    for (LeafNode* leaf = _firstLeaf(); leaf; leaf = leaf->nextLeaf) {
+        for (int i = 0; i < leaf->count; ++i)
+            visit(leaf->keys[i], leaf->values[i]);
+    }
+}
+
+
+// ---------------------------------------------------------------------
+//                        Public Iterator Methods
+
+/**
+ * @return Returns an iterator to the smallest key, or end() if the tree is empty.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::iterator BPlusTree<K,V,Compare>::begin() {
+    return iterator(this, _firstLeaf(), 0);
+}
+
+
+/**
+ * @return Returns the past-the-end iterator.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::iterator BPlusTree<K,V,Compare>::end() {
+    return iterator(this, nullptr, 0);
+}
+
+
+/**
+ * @param key - Key to search for.
+ * @return Returns an iterator to the first key >= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::iterator BPlusTree<K,V,Compare>::lower_bound(const K & key) {
+    if (!treeRoot)
+        return end();
+
+    PathStep path[MAX_HEIGHT];
+    int depth = 0;
+    LeafNode* leaf = _findLeaf(key, path, depth);
+
+    return _leafPosition(leaf, _lowerBound(leaf, key));
+}
+
+
+/**
+ * @param key - Key to search for.
+ * @return Returns an iterator to the first key > key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::iterator BPlusTree<K,V,Compare>::upper_bound(const K & key) {
+    if (!treeRoot)
+        return end();
+
+    PathStep path[MAX_HEIGHT];
+    int depth = 0;
+    LeafNode* leaf = _findLeaf(key, path, depth);
+
+    // _childIndex() counts the keys <= key
+    return _leafPosition(leaf, _childIndex(leaf, key));
+}
+
+
+// ---------------------------------------------------------------------
+//                       Public Range Query Methods
+//      Neighboring keys share a leaf or sit in the adjacent one, so each of
+//      these costs one descent plus at most one step along the leaf chain.
+
+/**
+ * @return Returns an iterator to the largest key <= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::iterator BPlusTree<K,V,Compare>::floor(const K & key) {
+    iterator above = upper_bound(key);
+
+    if (above == begin())
+        return end();
+
+    return --above;
+}
+
+
+/**
+ * @return Returns an iterator to the smallest key >= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::iterator BPlusTree<K,V,Compare>::ceil(const K & key) {
+    return lower_bound(key);
+}
+
+
+// ---------------------------------------------------------------------
+//                  Private Tree Management Methods
+
+/**
+ * Descends from the root to the leaf that does or would hold a key.
+ * @param key - Key to search for.
+ * @param path - Filled with each internal node visited and the child taken.
+ * @param depth - Set to the number of internal nodes on the path.
+ * @return Returns the leaf for the key.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::LeafNode* BPlusTree<K,V,Compare>::_findLeaf(const K & key, PathStep* path, int & depth) {
+    BPlusNode* currentNode = treeRoot;
+    depth = 0;
+
+    while (!currentNode->isLeaf) {
+        auto* internal = static_cast<InternalNode*>(currentNode);
+        int childIndex = _childIndex(internal, key);
+
+        path[depth++] = {internal, childIndex};
+        currentNode = internal->children[childIndex];
+    }
+
+    return static_cast<LeafNode*>(currentNode);
+}
+
+
+/**
+ * Adds a separator key and new right sibling to the parent at the end of a path,
+ * splitting full internal nodes upward and growing a new root if needed.
+ * @param path - Descent path recorded by _findLeaf().
+ * @param depth - Number of internal nodes on the path above the split node.
+ * @param separator - Smallest key in the new right node.
+ * @param rightNode - Node split off to the right of path[depth - 1]'s child.
+ */
+template <typename K, typename V, typename Compare>
+void BPlusTree<K,V,Compare>::_insertIntoParent(PathStep* path, int depth, const K & separator, BPlusNode* rightNode) {
+    K promotedKey = separator;
+    BPlusNode* promotedNode = rightNode;
+
+    while (depth > 0) {
+        --depth;
+        InternalNode* parent = path[depth].node;
+        int position = path[depth].childIndex;
+
+        // Parent has room, shift keys and children right of the split child
+        if (parent->count < NODE_KEYS) {
+            for (int i = parent->count; i > position; --i) {
+                parent->keys[i] = parent->keys[i - 1];
+                parent->children[i + 1] = parent->children[i];
+            }
+            parent->keys[position] = promotedKey;
+            parent->children[position + 1] = promotedNode;
+            ++parent->count;
+            return;
+        }
+
+        // Parent is full, lay out all keys and children in order then split
+        K allKeys[NODE_KEYS + 1];
+        BPlusNode* allChildren[NODE_KEYS + 2];
+
+        for (int i = 0, j = 0; i <= NODE_KEYS; ++i) {
+            if (i == position)
+                allKeys[i] = promotedKey;
+            else
+                allKeys[i] = parent->keys[j++];
+        }
+        for (int i = 0, j = 0; i <= NODE_KEYS + 1; ++i) {
+            if (i == position + 1)
+                allChildren[i] = promotedNode;
+            else
+                allChildren[i] = parent->children[j++];
+        }
+
+        InternalNode* rightParent = _internalPool.create();
+        int half = (NODE_KEYS + 1) / 2;     // allKeys[half] moves up
+
+        parent->count = half;
+        for (int i = 0; i < half; ++i) {
+            parent->keys[i] = allKeys[i];
+            parent->children[i] = allChildren[i];
+        }
+        parent->children[half] = allChildren[half];
+
+        rightParent->count = NODE_KEYS - half;
+        for (int i = half + 1; i <= NODE_KEYS; ++i) {
+            rightParent->keys[i - half - 1] = allKeys[i];
+            rightParent->children[i - half - 1] = allChildren[i];
+        }
+        rightParent->children[NODE_KEYS - half] = allChildren[NODE_KEYS + 1];
+
+        promotedKey = allKeys[half];
+        promotedNode = rightParent;
+    }
+
+    // Split reached the root, grow the tree by one level
+    InternalNode* newRoot = _internalPool.create();
+    newRoot->keys[0] = promotedKey;
+    newRoot->children[0] = treeRoot;
+    newRoot->children[1] = promotedNode;
+    newRoot->count = 1;
+    treeRoot = newRoot;
+
+} // End _insertIntoParent()
+
+
+/**
+ * Removes the child at the end of a path from its parent after that child was freed.
+ * Internal nodes left without children are freed in turn, and a root with a single
+ * child is replaced by that child.
+ * @param path - Descent path recorded by _findLeaf().
+ * @param depth - Number of internal nodes on the path above the freed child.
+ */
+template <typename K, typename V, typename Compare>
+void BPlusTree<K,V,Compare>::_removeFromParent(PathStep* path, int depth) {
+    if (depth == 0) {
+        // Freed node was the root, the tree is now empty
+        treeRoot = nullptr;
+        return;
+    }
+
+    InternalNode* parent = path[depth - 1].node;
+    int position = path[depth - 1].childIndex;
+
+    // Parent's only child was freed, free the parent as well
+    if (parent->count == 0) {
+        _internalPool.destroy(parent);
+        _removeFromParent(path, depth - 1);
+        return;
+    }
+
+    // Drop the child and the separator on one side of it
+    int keyIndex = (position > 0) ? position - 1 : 0;
+    for (int i = keyIndex; i < parent->count - 1; ++i)
+        parent->keys[i] = parent->keys[i + 1];
+    for (int i = position; i < parent->count; ++i)
+        parent->children[i] = parent->children[i + 1];
+    --parent->count;
+
+    // Root left with a single child, shrink the tree by one level
+    if (parent == treeRoot and parent->count == 0) {
+        treeRoot = parent->children[0];
+        _internalPool.destroy(parent);
+    }
+
+} // End _removeFromParent()
+
+
+/**
+ * Runs the destructor of every node in a subtree in place.
+ * @param node - Root of the subtree.
+ */
+template <typename K, typename V, typename Compare>
+void BPlusTree<K,V,Compare>::_destroySubtree(BPlusNode* node) {
+    if (node->isLeaf) {
+        static_cast<LeafNode*>(node)->~LeafNode();
+        return;
+    }
+
+    auto* internal = static_cast<InternalNode*>(node);
+    for (int i = 0; i <= internal->count; ++i)
+        _destroySubtree(internal->children[i]);
+
+    internal->~InternalNode();
+}
+
+
+/**
+ * @return Returns the leftmost leaf, or nullptr if the tree is empty.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::LeafNode* BPlusTree<K,V,Compare>::_firstLeaf() {
+    if (!treeRoot)
+        return nullptr;
+
+    BPlusNode* currentNode = treeRoot;
+    while (!currentNode->isLeaf)
+        currentNode = static_cast<InternalNode*>(currentNode)->children[0];
+
+    return static_cast<LeafNode*>(currentNode);
+}
+
+
+/**
+ * @return Returns the rightmost leaf, or nullptr if the tree is empty.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::LeafNode* BPlusTree<K,V,Compare>::_lastLeaf() {
+    if (!treeRoot)
+        return nullptr;
+
+    BPlusNode* currentNode = treeRoot;
+    while (!currentNode->isLeaf)
+        currentNode = static_cast<InternalNode*>(currentNode)->children[currentNode->count];
+
+    return static_cast<LeafNode*>(currentNode);
+}
+
+
+/**
+ * Makes an iterator from a leaf position, moving to the next leaf if the position
+ * is one past the leaf's last key.
+ */
+template <typename K, typename V, typename Compare>
+typename BPlusTree<K,V,Compare>::iterator BPlusTree<K,V,Compare>::_leafPosition(LeafNode* leaf, int position) {
+    if (position == leaf->count)
+        return iterator(this, leaf->nextLeaf, 0);
+
+    return iterator(this, leaf, position);
+}
+
+
+// ---------------------------------------------------------------------
+//                           Node Searches
+//      Scans count every key in the node without early exit, which keeps
+//      the loop branch-free and lets the compiler vectorize the compares.
+
+/**
+ * @return Returns the index of the child whose range holds a key.
+ */
+template <typename K, typename V, typename Compare>
+inline int BPlusTree<K,V,Compare>::_childIndex(const BPlusNode* node, const K & key) {
+    int index = 0;
+    for (int i = 0; i < node->count; ++i)
+        index += !_less(key, node->keys[i]);
+
+    return index;
+}
+
+
+/**
+ * @return Returns the index of the first key in a node that is not less than a key.
+ */
+template <typename K, typename V, typename Compare>
+inline int BPlusTree<K,V,Compare>::_lowerBound(const BPlusNode* node, const K & key) {
+    int index = 0;
+    for (int i = 0; i < node->count; ++i)
+        index += _less(node->keys[i], key);
+
+    return index;
+}
+
+
+#endif //BPLUSTREE_H
@@ -0,0 +1,142 @@
+//   File: Concurrent_CursedArray.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Thread-safe CursedArray declarations and definitions.
+//         Reads share the lock and run in parallel; writes take it exclusively,
+//         so every write is linearizable. The default ReadMostlyLock lets reads
+//         scale across cores instead of bouncing one lock word between them.
+//         With LazyAddTree storage a read pushes lazy tags down the tree, so
+//         reads take the lock exclusively too. Key is forwarded to CursedArray.
+// ---------------------------------------------------------------------
+
+#ifndef CONCURRENT_CURSED_ARRAY_H
+#define CONCURRENT_CURSED_ARRAY_H
+
+#include "CursedArray.cpp"
+#include "ReadMostlyLock.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+template <typename T, template <typename...> class Storage = RedBlackTree, typename Lock = ReadMostlyLock,
+          typename Key = float>
+class ConcurrentCursedArray {
+
+private:
+
+    struct Proxy {
+        ConcurrentCursedArray * _ca;
+        Key _key;
+    public:
+        Proxy( ConcurrentCursedArray * ca, const Key & key) : _ca(ca), _key(key) {}
+
+        operator T() const {
+            return _ca->get(_key);
+        }
+
+        void operator=(T value) {
+            _ca->set(_key, std::move(value));
+        }
+    };
+
+
+    CursedArray<T, Storage, Key> _array;
+    Lock _lock;
+
+public:
+    Proxy operator [](const Key & index) {
+        return Proxy(this, index);
+    }
+
+    T get(const Key & index);
+    void set(const Key & index, T value);
+
+    template <typename Reader>
+    auto read(Reader reader);
+    template <typename Writer>
+    auto write(Writer writer);
+
+    void freeze();
+    void thaw();
+};
+
+
+/**
+ * Reads the value at an index under a shared lock.
+ * @param index - Index to read.
+ * @return Returns a copy of the value, or a default value if the index is unset.
+ */
+template <typename T, template <typename...> class Storage, typename Lock, typename Key>
+T ConcurrentCursedArray<T, Storage, Lock, Key>::get(const Key & index) {
+    if constexpr (CursedArray<T, Storage, Key>::READS_MODIFY) {
+        std::unique_lock<Lock> guard(_lock);
+        return _array[index];
+    }
+
+    std::shared_lock<Lock> guard(_lock);
+    return _array[index];
+}
+
+
+/**
+ * Writes the value at an index under an exclusive lock.
+ * @param index - Index to write.
+ * @param value - Value to store.
+ */
+template <typename T, template <typename...> class Storage, typename Lock, typename Key>
+void ConcurrentCursedArray<T, Storage, Lock, Key>::set(const Key & index, T value) {
+    std::unique_lock<Lock> guard(_lock);
+    _array[index] = std::move(value);
+}
+
+
+/**
+ * Runs a read-only operation on the underlying CursedArray under a shared lock,
+ * e.g. a range scan with lower_bound(). The operation must not modify the array
+ * or keep iterators past its return.
+ * @param reader - Called as reader(CursedArray<T, Storage, Key> &).
+ * @return Returns whatever reader returns.
+ */
+template <typename T, template <typename...> class Storage, typename Lock, typename Key>
+template <typename Reader>
+auto ConcurrentCursedArray<T, Storage, Lock, Key>::read(Reader reader) {
+    if constexpr (CursedArray<T, Storage, Key>::READS_MODIFY) {
+        std::unique_lock<Lock> guard(_lock);
+        return reader(_array);
+    }
+
+    std::shared_lock<Lock> guard(_lock);
+    return reader(_array);
+}
+
+
+/**
+ * Runs an operation on the underlying CursedArray under an exclusive lock, e.g. a
+ * batch of writes that should appear to readers all at once.
+ * @param writer - Called as writer(CursedArray<T, Storage, Key> &).
+ * @return Returns whatever writer returns.
+ */
+template <typename T, template <typename...> class Storage, typename Lock, typename Key>
+template <typename Writer>
+auto ConcurrentCursedArray<T, Storage, Lock, Key>::write(Writer writer) {
+    std::unique_lock<Lock> guard(_lock);
+    return writer(_array);
+}
+
+
+template <typename T, template <typename...> class Storage, typename Lock, typename Key>
+void ConcurrentCursedArray<T, Storage, Lock, Key>::freeze() {
+    std::unique_lock<Lock> guard(_lock);
+    _array.freeze();
+}
+
+
+template <typename T, template <typename...> class Storage, typename Lock, typename Key>
+void ConcurrentCursedArray<T, Storage, Lock, Key>::thaw() {
+    std::unique_lock<Lock> guard(_lock);
+    _array.thaw();
+}
+
+
+#endif //CONCURRENT_CURSED_ARRAY_H
@@ -8,58 +8,1227 @@
 #define CURSED_ARRAY
 
 #include "RedBlack_Tree.h"
+#include "BPlus_Tree.h"
+#include "Frozen_Array.h"
+#include "Persistent_RedBlack_Tree.h"
+#include "Cursed_Snapshot.h"
+#include "Key_Traits.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-template <typename T>
+
+// Storage is any tree template taking <key, value> with the RedBlackTree interface,
+// e.g. RedBlackTree (default), OrderStatisticTree for rank()/select(), a RedBlackTree
+// with a RangeAggregate augmentation for aggregate(), LazyAddTree for addToAll()/addToRange(),
+// ValueIndexedTree for O(1) findByValue(), BPlusTree for read-heavy arrays, or
+// PersistentRedBlackTree for snapshot().
+// Key is the index type: float (default), double, an integer, FixedPoint, or std::string.
+// Indexes are stored as KeyTraits<Key> encodings and ordered by KeyCompare, both chosen
+// at compile time, so float, double, and FixedPoint indexes are compared as integers.
+template <typename T, template <typename...> class Storage = RedBlackTree, typename Key = float>
 class CursedArray {
 
 private:
+    using Traits = KeyTraits<Key>;
+    using EncodedKey = typename Traits::encoded_type;
+
+    // Arithmetic and FixedPoint indexes can be shifted; floating-point ones can also be scaled
+    static constexpr bool IS_SHIFTABLE = std::is_arithmetic<Key>::value or IsFixedPoint<Key>::value;
+    static constexpr bool IS_SCALABLE = std::is_floating_point<Key>::value;
+    using KeyOffset = typename std::conditional<IS_SCALABLE, double,
+                      typename std::conditional<IS_SHIFTABLE, Key, bool>::type>::type;
+
+    // Index = stored key * scale + offset. Shared by the array and its snapshots.
+    struct KeyMapping {
+        KeyOffset offset = KeyOffset();
+        double scale = 1.0;                 // Always a power of two
+
+        Key toStored(const Key & index, bool roundUp) const;
+        Key toLogical(const Key & stored) const;
+        bool findStored(const Key & index, Key & stored) const;
+        int compareMapped(const Key & stored, const Key & index) const;
+    };
 
     struct Proxy {   // https://stackoverflow.com/questions/18670530/properly-overloading-bracket-operator-for-hashtable-get-and-set
-        CursedArray<T> * _ca;
-        float _key;
+        CursedArray<T, Storage, Key> * _ca;
+        Key _key;
     public:
-        Proxy( CursedArray<T> * ca, float key) : _ca(ca), _key(key) {}
-        Proxy( CursedArray<T> const * ca, const float & key) : _ca(ca), _key(key) {}
+        Proxy( CursedArray<T, Storage, Key> * ca, const Key & key) : _ca(ca), _key(key) {}
 
         operator T() const {
+            CURSED_STATS(LatencyTimer timer(_ca->_readLatency));
             T* value = _ca->_get(_key);
             if (value)
                 return *value;
             else
-                
+                return T();     // Unset indexes read as a default value
         }
 
-        void operator=(T value) {
+        void operator=(const T & value) {
+            CURSED_STATS(LatencyTimer timer(_ca->_writeLatency));
             _ca->_set(_key, value);
         }
+
+        void operator=(T && value) {
+            CURSED_STATS(LatencyTimer timer(_ca->_writeLatency));
+            _ca->_set(_key, std::move(value));
+        }
     };
 
 
-    RedBlackTree<float, T> _tree;
+    Storage<EncodedKey, T> _tree;
+    FrozenArray<EncodedKey, T> _frozen;     // Holds the contents instead of _tree while frozen
+    bool _isFrozen = false;
+    KeyMapping _mapping;                    // Shift and scale from stored keys to indexes
+    double _keyStep = std::numeric_limits<double>::infinity();  // A power of two dividing every finite stored key
+#ifdef CURSED_ARRAY_STATS
+    LatencyHistogram _readLatency;      // operator[] reads
+    LatencyHistogram _writeLatency;     // operator[] assignments
+#endif
+
+    using TreeIterator = typename Storage<EncodedKey, T>::iterator;
+    using FrozenIterator = typename FrozenArray<EncodedKey, T>::iterator;
 
 public:
-    Proxy operator [](float index) {
+    // True when reads modify the storage (lazy tags are pushed down), so they need exclusive access
+    static constexpr bool READS_MODIFY = HasLazyTags<Storage<EncodedKey, T>>::value;
+
+    // Bidirectional iterator over the saved indexes in ascending order, whether or not
+    // the array is frozen. Dereferences to the value; key() gives the index.
+    class iterator {
+        friend class CursedArray;
+        const CursedArray* _array;     // For the index shift
+        TreeIterator _treeIt;
+        FrozenIterator _frozenIt;
+        bool _overFrozen;
+
+        iterator(const CursedArray* array, TreeIterator it) : _array{array}, _treeIt{it}, _overFrozen{false} {}
+        iterator(const CursedArray* array, FrozenIterator it) : _array{array}, _frozenIt{it}, _overFrozen{true} {}
+
+        const EncodedKey & _encodedKey() const { return _overFrozen ? _frozenIt.key() : _treeIt.key(); }
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = decltype(std::declval<const TreeIterator &>().value());     // const T& for persistent storage
+        using pointer = typename std::remove_reference<reference>::type*;
+
+        iterator() : _array{nullptr}, _overFrozen{false} {}
+
+        Key key() const { return _array->_mapping.toLogical(Traits::decode(_encodedKey())); }
+        reference value() const { return _overFrozen ? _frozenIt.value() : _treeIt.value(); }
+        reference operator*() const { return value(); }
+        pointer operator->() const { return &value(); }
+
+        iterator & operator++() {
+            if (_overFrozen) ++_frozenIt; else ++_treeIt;
+            return *this;
+        }
+        iterator & operator--() {
+            if (_overFrozen) --_frozenIt; else --_treeIt;
+            return *this;
+        }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        iterator operator--(int) { iterator old = *this; --*this; return old; }
+
+        bool operator==(const iterator & other) const {
+            return _overFrozen ? _frozenIt == other._frozenIt : _treeIt == other._treeIt;
+        }
+        bool operator!=(const iterator & other) const { return !(*this == other); }
+    };
+
+    // Read-only view of the array at one moment (PersistentRedBlackTree storage).
+    // It never changes, and it can be copied and read on any thread while the array is written.
+    class Snapshot {
+        friend class CursedArray;
+        using Version = typename Storage<EncodedKey, T>::Snapshot;
+        Version _version;
+        KeyMapping _mapping;    // Shift and scale when the snapshot was taken
+
+        Snapshot(Version version, const KeyMapping & mapping) : _version{std::move(version)}, _mapping{mapping} {}
+    public:
+        Snapshot() = default;
+
+        T operator [](const Key & index) const;
+        const T* findValue(const Key & index) const;
+        int size() const { return _version.size(); }
+
+        template <typename Visitor>
+        void visitInOrder(Visitor visit) const;
+        template <typename Visitor>
+        void visitRange(const Key & low, const Key & high, Visitor visit) const;
+    };
+
+    Proxy operator [](const Key & index) {
         return Proxy(this, index);
     }
 
+    bool remove(const Key & index);
+    int size();
+
+    // In-place Insertion Methods
+    template <typename... Args>
+    std::pair<T*, bool> try_emplace(const Key & index, Args &&... args);
+    template <typename... Args>
+    std::pair<T*, bool> emplace(const Key & index, Args &&... args);
+    template <typename M>
+    std::pair<T*, bool> insert_or_assign(const Key & index, M && value);
+
+    // Index Shift Methods (arithmetic and FixedPoint indexes)
+    void shiftIndexes(const Key & delta);
+    bool scaleIndexes(double factor);
+    CursedArray & operator ++();
+    CursedArray & operator +=(const Key & delta);
+    KeyOffset keyOffset() const { return _mapping.offset; }
+    double keyScale() const { return _mapping.scale; }
+
+    // Snapshot Methods (trivially copyable T only)
+    bool save(const std::string & path);
+    bool load(const std::string & path);
+
+    template <typename KeyIt, typename ValueIt>
+    void assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue);
+    template <typename KeyIt, typename ValueIt>
+    void assign(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue);
+
+    void freeze();
+    void thaw();
+    bool isFrozen() const { return _isFrozen; }
+
+    // Version Methods (PersistentRedBlackTree storage)
+    Snapshot snapshot();
+
+    iterator begin();
+    iterator end();
+    iterator lower_bound(const Key & index);
+    iterator upper_bound(const Key & index);
+    std::pair<iterator, iterator> equal_range(const Key & index);
+
+    iterator floor(const Key & index);
+    iterator ceil(const Key & index);
+    iterator nearest(const Key & index);
+    std::vector<iterator> kNearest(const Key & index, int k);
+
+    int rank(const Key & index);
+    iterator select(int position);
+
+    auto aggregate(const Key & low, const Key & high);
+
+    // Bulk Value Methods (LazyAddTree storage)
+    void addToAll(const T & delta);
+    void addToRange(const Key & low, const Key & high, const T & delta);
+
+    // Reverse Lookup Methods (RedBlackTree storage)
+    bool findByValue(const T & value, Key & index);
+    std::vector<Key> findIndexes(const T & value);
+
+#ifdef CURSED_ARRAY_STATS
+    // Stats (CURSED_ARRAY_STATS builds only)
+    const LatencyHistogram & readLatency() const { return _readLatency; }
+    const LatencyHistogram & writeLatency() const { return _writeLatency; }
+    void reportStats(std::ostream & out);
+#endif
+
 
 private:
-    T* _get(float index);
-    void _set(float index, T value);
+    EncodedKey _encodeCeil(const Key & index) const { return Traits::encode(_mapping.toStored(index, true)); }
+    EncodedKey _encodeFloor(const Key & index) const { return Traits::encode(_mapping.toStored(index, false)); }
+    EncodedKey _encodeForWrite(const Key & index);
+    static bool _ceilIsCloser(const Key & index, const Key & floorIndex, const Key & ceilIndex);
+
+    void _noteStoredKey(const Key & stored);
+    double _largestStoredMagnitude();
+    template <typename F>
+    void _rekey(F newIndex);
+    static bool _foldsExactly(double step, double bound);
+    static double _stepOf(double value);
+    static Key _roundToKey(double value);
+
+    T* _get(const Key & index);
+    template <typename U>
+    void _set(const Key & index, U && value);
 };
 
 
-template <typename T>
-T* CursedArray<T>::_get(float index) {
-    return &_tree.findValue(index);
+/**
+ * Replaces the contents of the array with a sorted range in O(n).
+ * @param firstKey, lastKey - Indexes in strictly ascending order.
+ * @param firstValue - Start of the values matching each index.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename KeyIt, typename ValueIt>
+void CursedArray<T, Storage, Key>::assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue) {
+    std::vector<EncodedKey> keys;
+    _keyStep = std::numeric_limits<double>::infinity();
+    for (; firstKey != lastKey; ++firstKey) {
+        keys.push_back(Traits::encode(*firstKey));
+        _noteStoredKey(*firstKey);
+    }
+
+    _frozen.clear();
+    _isFrozen = false;
+    _mapping = KeyMapping();
+    _tree.assignSorted(keys.begin(), keys.end(), firstValue);
+}
+
+
+/**
+ * Replaces the contents of the array with an unsorted range, sorting it first (a
+ * radix sort in O(n) for integer-encoded indexes). If an index repeats, the last value for it wins.
+ * @param firstKey, lastKey - Indexes in any order.
+ * @param firstValue - Start of the values matching each index.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename KeyIt, typename ValueIt>
+void CursedArray<T, Storage, Key>::assign(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue) {
+    std::vector<EncodedKey> keys;
+    std::vector<T> values;
+    _keyStep = std::numeric_limits<double>::infinity();
+    for (; firstKey != lastKey; ++firstKey, ++firstValue) {
+        keys.push_back(Traits::encode(*firstKey));
+        values.push_back(*firstValue);
+        _noteStoredKey(*firstKey);
+    }
+
+    std::vector<int> order;
+    if constexpr (std::is_unsigned<EncodedKey>::value) {
+        order = radixSortOrder(keys);
+    } else {
+        order.resize(keys.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = int(i);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return KeyCompare<EncodedKey>::compare(keys[a], keys[b]) < 0;
+        });
+    }
+
+    // Keep only the last of each run of equal indexes
+    std::vector<EncodedKey> sortedKeys;
+    std::vector<T> sortedValues;
+    sortedKeys.reserve(order.size());
+    sortedValues.reserve(order.size());
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 < order.size() and KeyCompare<EncodedKey>::compare(keys[order[i]], keys[order[i + 1]]) == 0)
+            continue;
+
+        sortedKeys.push_back(keys[order[i]]);
+        sortedValues.push_back(std::move(values[order[i]]));
+    }
+
+    _frozen.clear();
+    _isFrozen = false;
+    _mapping = KeyMapping();
+    _tree.assignSorted(sortedKeys.begin(), sortedKeys.end(), std::make_move_iterator(sortedValues.begin()));
+}
+
+
+/**
+ * Removes an index from the array, thawing it first if it is frozen and holds the index.
+ * @param index - Index to remove.
+ * @return Returns true if the index was saved.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::remove(const Key & index) {
+    Key stored;
+    if (!_mapping.findStored(index, stored))
+        return false;
+
+    EncodedKey key = Traits::encode(stored);
+
+    if (_isFrozen) {
+        if (!_frozen.findValue(key))
+            return false;
+        thaw();
+    }
+
+    return _tree.remove(key);
+}
+
+
+/**
+ * @return Returns the number of saved indexes.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+int CursedArray<T, Storage, Key>::size() {
+    return _isFrozen ? _frozen.size() : _tree.size();
+}
+
+
+/**
+ * Constructs a value at an unset index from the given arguments, without a
+ * default-constructed temporary or any copies. Leaves a saved index untouched.
+ * @param index - Index to fill.
+ * @param args - Arguments for T's constructor.
+ * @return Returns the value at the index and whether it was inserted.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename... Args>
+std::pair<T*, bool> CursedArray<T, Storage, Key>::try_emplace(const Key & index, Args &&... args) {
+    if (_isFrozen) {
+        if (T* value = _get(index))
+            return {value, false};
+        thaw();
+    }
+
+    return _tree.try_emplace(_encodeForWrite(index), std::forward<Args>(args)...);
+}
+
+
+/**
+ * Same as try_emplace().
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename... Args>
+std::pair<T*, bool> CursedArray<T, Storage, Key>::emplace(const Key & index, Args &&... args) {
+    return try_emplace(index, std::forward<Args>(args)...);
+}
+
+
+/**
+ * Writes a value at an index, moving an rvalue straight into the tree.
+ * @param index - Index to write.
+ * @param value - Anything assignable to T.
+ * @return Returns the value at the index and whether the index was newly saved.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename M>
+std::pair<T*, bool> CursedArray<T, Storage, Key>::insert_or_assign(const Key & index, M && value) {
+    if (_isFrozen)
+        thaw();
+
+    return _tree.insert_or_assign(_encodeForWrite(index), std::forward<M>(value));
+}
+
+
+/**
+ * Adds delta to every index in O(1). The offset is stored once and folded into each
+ * lookup and into iterator::key(), so no node is touched and order is preserved.
+ * Integer indexes must not overflow.
+ * A floating-point shift stays O(1) while every shifted index is still exactly a Key
+ * (e.g. whole-number indexes shifted by whole numbers). Otherwise the indexes are
+ * rounded and rewritten in O(n), as if each were moved by hand: indexes that round
+ * to the same Key keep the value of the greatest one.
+ * @param delta - Amount to add to every index.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+void CursedArray<T, Storage, Key>::shiftIndexes(const Key & delta) {
+    static_assert(IS_SHIFTABLE, "Only arithmetic and FixedPoint indexes can be shifted");
+
+    if constexpr (IS_SCALABLE) {
+        double step = std::min({_keyStep * _mapping.scale, _stepOf(_mapping.offset), _stepOf(double(delta))});
+        double bound = _largestStoredMagnitude() * _mapping.scale + std::fabs(_mapping.offset) + std::fabs(double(delta));
+
+        if (std::isfinite(delta) and _foldsExactly(step, bound))
+            _mapping.offset += double(delta);
+        else
+            _rekey([&](const Key & index) { return _roundToKey(double(index) + double(delta)); });
+    } else {
+        _mapping.offset = _mapping.offset + delta;
+    }
+}
+
+
+/**
+ * Multiplies every index by a positive factor. Floating-point indexes only.
+ * A power of two is folded in O(1) while every scaled index is still exactly a Key;
+ * other factors round and rewrite the indexes in O(n), like shiftIndexes().
+ * @param factor - Positive, finite multiplier; a negative one would reverse the order.
+ * @return Returns false, leaving the indexes unchanged, if factor is not positive and finite.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::scaleIndexes(double factor) {
+    static_assert(IS_SCALABLE, "Only floating-point indexes can be scaled");
+
+    if (!(factor > 0.0) or factor == std::numeric_limits<double>::infinity())
+        return false;
+
+    int exponent;
+    if (std::frexp(factor, &exponent) == 0.5) {
+        double step = std::min(_keyStep * _mapping.scale, _stepOf(_mapping.offset)) * factor;
+        double bound = (_largestStoredMagnitude() * _mapping.scale + std::fabs(_mapping.offset)) * factor;
+
+        if (_foldsExactly(step, bound)) {
+            _mapping.scale *= factor;
+            _mapping.offset *= factor;
+            return true;
+        }
+    }
+
+    _rekey([&](const Key & index) { return _roundToKey(double(index) * factor); });
+    return true;
+}
+
+
+/**
+ * Moves every index up by one in O(1).
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+CursedArray<T, Storage, Key> & CursedArray<T, Storage, Key>::operator ++() {
+    shiftIndexes(Key(1));
+    return *this;
+}
+
+
+/**
+ * Adds delta to every index in O(1). A negative delta moves the indexes down.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+CursedArray<T, Storage, Key> & CursedArray<T, Storage, Key>::operator +=(const Key & delta) {
+    shiftIndexes(delta);
+    return *this;
+}
+
+
+/**
+ * Writes the contents to a flat, sorted snapshot file in O(n). Float indexes only.
+ * The file can be queried in place with MappedCursedArray or read back with load().
+ * @param path - File to write; replaced atomically.
+ * @return Returns true if the snapshot was written.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::save(const std::string & path) {
+    static_assert(std::is_same<Key, float>::value, "Snapshots store float indexes");
+
+    return writeSnapshot<T>(path, uint64_t(size()), [this](auto visit) {
+        for (iterator it = begin(); it != end(); ++it)
+            visit(it.key(), it.value());
+    });
+}
+
+
+/**
+ * Replaces the contents with a snapshot written by save(), bulk-building the tree in O(n).
+ * @param path - Snapshot file.
+ * @return Returns false, leaving the array unchanged, if the file is missing or not a valid snapshot of T.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::load(const std::string & path) {
+    static_assert(std::is_same<Key, float>::value, "Snapshots store float indexes");
+
+    MappedCursedArray<T> snapshot;
+    if (!snapshot.open(path))
+        return false;
+
+    const float* firstKey = snapshot.keys();
+    const float* lastKey = firstKey + snapshot.size();
+    auto outOfOrder = [](float a, float b) { return !(Traits::encode(a) < Traits::encode(b)); };
+    if (std::adjacent_find(firstKey, lastKey, outOfOrder) != lastKey)
+        return false;   // Keys must be strictly ascending
+
+    assignSorted(firstKey, lastKey, snapshot.values());
+    return true;
+}
+
+
+/**
+ * Moves the contents into a packed, read-only array for faster reads.
+ * The tree's nodes are released. Assigning to an index thaws the array again.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+void CursedArray<T, Storage, Key>::freeze() {
+    if (_isFrozen)
+        return;
+
+    std::vector<EncodedKey> keys;
+    std::vector<T> values;
+    keys.reserve(_tree.size());
+    values.reserve(_tree.size());
+
+    _tree.visitInOrder([&](const EncodedKey & key, auto & value) {
+        keys.push_back(key);
+        values.push_back(std::move(value));     // Copies values a persistent tree shares with snapshots
+    });
+
+    _frozen.assign(keys, values);
+    _tree.clear();
+    _isFrozen = true;
+}
+
+
+/**
+ * Moves the contents of a frozen array back into a mutable tree.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+void CursedArray<T, Storage, Key>::thaw() {
+    if (!_isFrozen)
+        return;
+
+    std::vector<EncodedKey> keys;
+    std::vector<T> values;
+    keys.reserve(_frozen.size());
+    values.reserve(_frozen.size());
+
+    _frozen.visitInOrder([&](const EncodedKey & key, T & value) {
+        keys.push_back(key);
+        values.push_back(std::move(value));
+    });
+
+    _tree.assignSorted(keys.begin(), keys.end(), std::make_move_iterator(values.begin()));
+
+    _frozen.clear();
+    _isFrozen = false;
+}
+
+
+/**
+ * Takes a read-only view of the array in O(1), thawing it first if it is frozen.
+ * Later writes copy the nodes they change, so the view never sees them.
+ * Readers on other threads may call this while indexes are written or removed, but
+ * not while the array is shifted, scaled, frozen, or reassigned: those change the
+ * index mapping, and a write to a shifted floating-point array may rekey it.
+ * Snapshots share values with the array, so change values only by assigning them;
+ * never write through the pointers try_emplace() and insert_or_assign() return.
+ * @return Returns the view; each reader keeps its own copy.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::Snapshot CursedArray<T, Storage, Key>::snapshot() {
+    if (_isFrozen)
+        thaw();
+
+    return Snapshot(_tree.snapshot(), _mapping);
+}
+
+
+/**
+ * @return Returns the value at an index in the view, or a default value if it was unset.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+T CursedArray<T, Storage, Key>::Snapshot::operator [](const Key & index) const {
+    const T* value = findValue(index);
+    return value ? *value : T();
+}
+
+
+/**
+ * @return Returns the value at an index in the view, or nullptr if it was unset.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+const T* CursedArray<T, Storage, Key>::Snapshot::findValue(const Key & index) const {
+    Key stored;
+    if (!_mapping.findStored(index, stored))
+        return nullptr;
+
+    return _version.findValue(Traits::encode(stored));
+}
+
+
+/**
+ * Visits every index in the view in ascending order.
+ * @param visit - Called as visit(index, value).
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename Visitor>
+void CursedArray<T, Storage, Key>::Snapshot::visitInOrder(Visitor visit) const {
+    _version.visitInOrder([&](const EncodedKey & key, const T & value) {
+        visit(_mapping.toLogical(Traits::decode(key)), value);
+    });
+}
+
+
+/**
+ * Visits the indexes in [low, high] in ascending order.
+ * @param visit - Called as visit(index, value).
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename Visitor>
+void CursedArray<T, Storage, Key>::Snapshot::visitRange(const Key & low, const Key & high, Visitor visit) const {
+    EncodedKey lowKey = Traits::encode(_mapping.toStored(low, true));
+    EncodedKey highKey = Traits::encode(_mapping.toStored(high, false));
+
+    _version.visitRange(lowKey, highKey, [&](const EncodedKey & key, const T & value) {
+        visit(_mapping.toLogical(Traits::decode(key)), value);
+    });
+}
+
+
+/**
+ * @return Returns an iterator to the smallest saved index.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::begin() {
+    if (_isFrozen)
+        return iterator(this, _frozen.begin());
+
+    return iterator(this, _tree.begin());
+}
+
+
+/**
+ * @return Returns the past-the-end iterator.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::end() {
+    if (_isFrozen)
+        return iterator(this, _frozen.end());
+
+    return iterator(this, _tree.end());
+}
+
+
+/**
+ * Finds the first saved index that is not less than a given index in O(log n).
+ * Walking forward from it visits a key range without copying any keys.
+ * @param index - Index to search for.
+ * @return Returns an iterator to the first saved index >= index, or end().
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::lower_bound(const Key & index) {
+    if (_isFrozen)
+        return iterator(this, _frozen.lower_bound(_encodeCeil(index)));
+
+    return iterator(this, _tree.lower_bound(_encodeCeil(index)));
 }
 
 
-template <typename T>
-void CursedArray<T>::_set(float index, T value) {
-    _tree.insert(index, value);
+/**
+ * Finds the first saved index that is greater than a given index in O(log n).
+ * @param index - Index to search for.
+ * @return Returns an iterator to the first saved index > index, or end().
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::upper_bound(const Key & index) {
+    if (_isFrozen)
+        return iterator(this, _frozen.upper_bound(_encodeFloor(index)));
+
+    return iterator(this, _tree.upper_bound(_encodeFloor(index)));
+}
+
+
+/**
+ * @param index - Index to search for.
+ * @return Returns the range of saved indexes equal to index (empty or one element).
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+std::pair<typename CursedArray<T, Storage, Key>::iterator, typename CursedArray<T, Storage, Key>::iterator>
+CursedArray<T, Storage, Key>::equal_range(const Key & index) {
+    return {lower_bound(index), upper_bound(index)};
+}
+
+
+/**
+ * @param index - Index to search for.
+ * @return Returns an iterator to the largest saved index <= index, or end().
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::floor(const Key & index) {
+    if (_isFrozen)
+        return iterator(this, _frozen.floor(_encodeFloor(index)));
+
+    return iterator(this, _tree.floor(_encodeFloor(index)));
+}
+
+
+/**
+ * @param index - Index to search for.
+ * @return Returns an iterator to the smallest saved index >= index, or end().
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::ceil(const Key & index) {
+    if (_isFrozen)
+        return iterator(this, _frozen.ceil(_encodeCeil(index)));
+
+    return iterator(this, _tree.ceil(_encodeCeil(index)));
+}
+
+
+/**
+ * Finds the saved index closest to an index in one descent and one step, for lookups
+ * by indexes that rarely match exactly (e.g. timestamps). Ties go to the smaller index.
+ * Distances are measured on the decoded indexes, not on their integer encodings.
+ * @param index - Index to search for.
+ * @return Returns an iterator to the closest saved index, or end() if the array is empty.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::nearest(const Key & index) {
+    iterator ceilIt = lower_bound(index);
+    if (ceilIt != end() and Traits::encode(ceilIt.key()) == Traits::encode(index))
+        return ceilIt;
+    if (ceilIt == begin())
+        return ceilIt;
+
+    iterator floorIt = std::prev(ceilIt);
+    if (ceilIt == end())
+        return floorIt;
+
+    return _ceilIsCloser(index, floorIt.key(), ceilIt.key()) ? ceilIt : floorIt;
+}
+
+
+/**
+ * Finds the k saved indexes closest to an index in O(log n + k).
+ * Starts on either side of the index and repeatedly takes the closer neighbor.
+ * @param index - Index to search for.
+ * @param k - Number of indexes to return.
+ * @return Returns up to k iterators ordered from closest to farthest. Ties go to the smaller index.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+std::vector<typename CursedArray<T, Storage, Key>::iterator> CursedArray<T, Storage, Key>::kNearest(const Key & index, int k) {
+    std::vector<iterator> nearestIndexes;
+    iterator first = begin();
+    iterator last = end();
+
+    iterator ceilIt = lower_bound(index);
+    iterator floorIt = ceilIt;
+    bool hasFloor = (floorIt != first);
+    if (hasFloor)
+        --floorIt;
+
+    while (int(nearestIndexes.size()) < k and (hasFloor or ceilIt != last)) {
+        if (ceilIt == last or (hasFloor and !_ceilIsCloser(index, floorIt.key(), ceilIt.key()))) {
+            nearestIndexes.push_back(floorIt);
+            hasFloor = (floorIt != first);
+            if (hasFloor)
+                --floorIt;
+        } else {
+            nearestIndexes.push_back(ceilIt);
+            ++ceilIt;
+        }
+    }
+
+    return nearestIndexes;
+}
+
+
+/**
+ * Counts the saved indexes below an index in O(log n). Needs OrderStatisticTree storage.
+ * @param index - Index to rank. Does not need to be saved.
+ * @return Returns the number of saved indexes < index.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+int CursedArray<T, Storage, Key>::rank(const Key & index) {
+    if (_isFrozen)
+        return _frozen.rank(_encodeCeil(index));
+
+    return _tree.rank(_encodeCeil(index));
+}
+
+
+/**
+ * Finds the i-th smallest saved index in O(log n). Needs OrderStatisticTree storage.
+ * @param position - 0 for the smallest saved index.
+ * @return Returns an iterator to the index, or end() if position is out of range.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::iterator CursedArray<T, Storage, Key>::select(int position) {
+    if (_isFrozen)
+        return iterator(this, _frozen.select(position));
+
+    return iterator(this, _tree.select(position));
+}
+
+
+/**
+ * Combines the values saved at indexes in [low, high]. Needs RedBlackTree storage with
+ * a RangeAggregate augmentation, which answers in O(log n); a frozen array folds the
+ * range in O(log n + k) instead.
+ * @param low, high - Inclusive index bounds.
+ * @return Returns the monoid combination of the values, or the monoid identity if none.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+auto CursedArray<T, Storage, Key>::aggregate(const Key & low, const Key & high) {
+    using Monoid = typename Storage<EncodedKey, T>::augment_type::Monoid;
+
+    if (_isFrozen) {
+        typename Monoid::value_type total = Monoid::identity();
+        if (KeyCompare<EncodedKey>::compare(_encodeFloor(high), _encodeCeil(low)) < 0)
+            return total;   // Empty range; the walk below would run past last
+
+        auto last = _frozen.upper_bound(_encodeFloor(high));
+        for (auto it = _frozen.lower_bound(_encodeCeil(low)); it != last; ++it)
+            total = Monoid::combine(total, Monoid::fromValue(*it));
+        return total;
+    }
+
+    return _tree.aggregate(_encodeCeil(low), _encodeFloor(high));
+}
+
+
+/**
+ * Adds a delta to every saved value. Needs LazyAddTree storage, which does this in
+ * O(1); a frozen array adds to each value in O(n) instead.
+ * Values read through earlier iterators or pointers are stale afterwards.
+ * @param delta - Amount to add.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+void CursedArray<T, Storage, Key>::addToAll(const T & delta) {
+    if (_isFrozen) {
+        for (auto it = _frozen.begin(); it != _frozen.end(); ++it)
+            *it += delta;
+        return;
+    }
+
+    _tree.addToAll(delta);
+}
+
+
+/**
+ * Adds a delta to the values saved at indexes in [low, high]. Needs LazyAddTree
+ * storage, which does this in O(log n); a frozen array adds in O(log n + k) instead.
+ * Values read through earlier iterators or pointers are stale afterwards.
+ * @param low, high - Inclusive index bounds.
+ * @param delta - Amount to add.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+void CursedArray<T, Storage, Key>::addToRange(const Key & low, const Key & high, const T & delta) {
+    if (_isFrozen) {
+        if (KeyCompare<EncodedKey>::compare(_encodeFloor(high), _encodeCeil(low)) < 0)
+            return;     // Empty range; the walk below would run past last
+
+        auto last = _frozen.upper_bound(_encodeFloor(high));
+        for (auto it = _frozen.lower_bound(_encodeCeil(low)); it != last; ++it)
+            *it += delta;
+        return;
+    }
+
+    _tree.addToRange(_encodeCeil(low), _encodeFloor(high), delta);
+}
+
+
+/**
+ * Finds an index holding a value. ValueIndexedTree storage answers in O(1) expected;
+ * other RedBlackTree storage and frozen arrays scan in O(n). The lookup refreshes the
+ * index, so a ConcurrentCursedArray must call it through write().
+ * @param value - Value to search for.
+ * @param index - Set to an index holding the value (the smallest when scanning).
+ * @return Returns false if no index holds the value.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::findByValue(const T & value, Key & index) {
+    if (_isFrozen) {
+        for (auto it = _frozen.begin(); it != _frozen.end(); ++it) {
+            if (*it == value) {
+                index = _mapping.toLogical(Traits::decode(it.key()));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const EncodedKey* key = _tree.findKey(value);
+    if (!key)
+        return false;
+
+    index = _mapping.toLogical(Traits::decode(*key));
+    return true;
+}
+
+
+/**
+ * Finds every index holding a value, like findByValue().
+ * @param value - Value to search for.
+ * @return Returns the indexes in ascending order.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+std::vector<Key> CursedArray<T, Storage, Key>::findIndexes(const T & value) {
+    std::vector<Key> indexes;
+
+    if (_isFrozen) {
+        for (auto it = _frozen.begin(); it != _frozen.end(); ++it) {
+            if (*it == value)
+                indexes.push_back(_mapping.toLogical(Traits::decode(it.key())));
+        }
+        return indexes;
+    }
+
+    for (const EncodedKey & key : _tree.findKeys(value))
+        indexes.push_back(_mapping.toLogical(Traits::decode(key)));
+
+    return indexes;
+}
+
+
+#ifdef CURSED_ARRAY_STATS
+/**
+ * Writes operator[] latency percentiles followed by the tree's counters and shape.
+ * Needs a Storage with reportStats(), e.g. RedBlackTree.
+ * @param out - Stream to write to.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+void CursedArray<T, Storage, Key>::reportStats(std::ostream & out) {
+    _readLatency.report(out, "read");
+    _writeLatency.report(out, "write");
+    _tree.reportStats(out);
+}
+#endif
+
+
+// ---------------------------------------------------------------------
+//                          Index Mapping
+
+// Floating-point keys keep one invariant while shifted or scaled: every finite stored
+// key s maps to exactly s * scale + offset, which is itself a Key. So no two
+// keys share an index, and an index found by iterating finds its value again.
+
+/**
+ * Maps an index to the key it is stored under.
+ * @param roundUp - For floating-point indexes no stored key maps onto: true for the
+ *                  smallest key above the index, false for the largest below it.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+Key CursedArray<T, Storage, Key>::KeyMapping::toStored(const Key & index, bool roundUp) const {
+    if constexpr (IS_SCALABLE) {
+        if (!std::isfinite(index) or (scale == 1.0 and offset == 0.0))
+            return index;   // Infinities and NaN never move
+
+        // Start from the rounded inverse, then step to the exact bound
+        const Key up = std::numeric_limits<Key>::infinity();
+        Key stored = _roundToKey((double(index) - offset) / scale);
+        if (roundUp) {
+            while (compareMapped(stored, index) < 0)
+                stored = std::nextafter(stored, up);
+            while (compareMapped(std::nextafter(stored, -up), index) >= 0)
+                stored = std::nextafter(stored, -up);
+        } else {
+            while (compareMapped(stored, index) > 0)
+                stored = std::nextafter(stored, -up);
+            while (compareMapped(std::nextafter(stored, up), index) <= 0)
+                stored = std::nextafter(stored, up);
+        }
+        return stored;
+    } else if constexpr (IS_SHIFTABLE) {
+        return index - offset;
+    } else {
+        return index;
+    }
+}
+
+
+/**
+ * Maps a stored key back to the index it currently stands for. Exact for every stored key.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+Key CursedArray<T, Storage, Key>::KeyMapping::toLogical(const Key & stored) const {
+    if constexpr (IS_SCALABLE)
+        return Key(double(stored) * scale + offset);
+    else if constexpr (IS_SHIFTABLE)
+        return stored + offset;
+    else
+        return stored;
+}
+
+
+/**
+ * @param stored - Set to the key the index is stored under.
+ * @return Returns false if no key maps exactly onto the index, so it cannot be saved
+ *         without folding the shift and scale into the keys first.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::KeyMapping::findStored(const Key & index, Key & stored) const {
+    stored = toStored(index, true);
+
+    if constexpr (IS_SCALABLE)
+        return !std::isfinite(index) or compareMapped(stored, index) == 0;
+    else
+        return true;
+}
+
+
+/**
+ * Maps an index to the key a write saves it under. If no key maps exactly onto it,
+ * the shift and scale are folded into the keys first in O(n).
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+typename CursedArray<T, Storage, Key>::EncodedKey CursedArray<T, Storage, Key>::_encodeForWrite(const Key & index) {
+    Key stored;
+    if constexpr (IS_SCALABLE) {
+        if (!_mapping.findStored(index, stored)) {
+            _rekey([](const Key & unchanged) { return unchanged; });
+            stored = index;
+        }
+        _noteStoredKey(stored);
+    } else {
+        _mapping.findStored(index, stored);
+    }
+
+    return Traits::encode(stored);
+}
+
+
+/**
+ * Compares stored * scale + offset with an index without rounding the sum.
+ * Floating-point indexes only.
+ * @return Returns negative, zero, or positive, like KeyCompare.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+int CursedArray<T, Storage, Key>::KeyMapping::compareMapped(const Key & stored, const Key & index) const {
+    if (!std::isfinite(stored))
+        return (stored < 0) ? -1 : 1;
+
+    // Two-sum: sum + error is exactly scaled + offset (scaling by a power of two is exact)
+    double scaled = double(stored) * scale;
+    double sum = scaled + offset;
+    double offsetPart = sum - scaled;
+    double error = (scaled - (sum - offsetPart)) + (offset - offsetPart);
+
+    if (sum != double(index))
+        return (sum < double(index)) ? -1 : 1;
+    return int(error > 0) - int(error < 0);
+}
+
+
+/**
+ * Measures distances on the indexes themselves, never on their encodings. Integer
+ * distances are taken as unsigned, so they cannot overflow.
+ * @param floorIndex, ceilIndex - Indexes with floorIndex <= index <= ceilIndex.
+ * @return Returns true if ceilIndex is strictly closer to index than floorIndex.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::_ceilIsCloser(const Key & index, const Key & floorIndex, const Key & ceilIndex) {
+    if constexpr (IsFixedPoint<Key>::value) {
+        using Distance = typename std::make_unsigned<decltype(index.raw)>::type;
+        return Distance(Distance(ceilIndex.raw) - Distance(index.raw))
+               < Distance(Distance(index.raw) - Distance(floorIndex.raw));
+    } else if constexpr (std::is_integral<Key>::value) {
+        using Distance = typename std::make_unsigned<Key>::type;
+        return Distance(Distance(ceilIndex) - Distance(index)) < Distance(Distance(index) - Distance(floorIndex));
+    } else {
+        return ceilIndex - index < index - floorIndex;
+    }
+}
+
+
+template <typename T, template <typename...> class Storage, typename Key>
+void CursedArray<T, Storage, Key>::_noteStoredKey(const Key & stored) {
+    if constexpr (IS_SCALABLE)
+        _keyStep = std::min(_keyStep, _stepOf(double(stored)));
+}
+
+
+/**
+ * @return Returns the largest magnitude of a finite stored key, or 0 if there is none.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+double CursedArray<T, Storage, Key>::_largestStoredMagnitude() {
+    // Infinities and NaN sort to the ends, so at most three are skipped
+    double largest = 0.0;
+    for (iterator it = begin(); it != end(); ++it) {
+        Key stored = Traits::decode(it._encodedKey());
+        if (std::isfinite(stored)) {
+            largest = std::fabs(double(stored));
+            break;
+        }
+    }
+    for (iterator it = end(); it != begin(); ) {
+        Key stored = Traits::decode((--it)._encodedKey());
+        if (std::isfinite(stored))
+            return std::max(largest, std::fabs(double(stored)));
+    }
+    return largest;
+}
+
+
+/**
+ * Rewrites every key in O(n) as newIndex(its index) and resets the shift and scale.
+ * @param newIndex - Never-decreasing map of indexes. Indexes it sends to the same Key
+ *                   keep the value of the greatest one.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename F>
+void CursedArray<T, Storage, Key>::_rekey(F newIndex) {
+    std::vector<EncodedKey> keys;
+    std::vector<T> values;
+    keys.reserve(size());
+    values.reserve(size());
+    _keyStep = std::numeric_limits<double>::infinity();
+
+    auto rewrite = [&](const EncodedKey & key, auto & value) {
+        Key index = newIndex(_mapping.toLogical(Traits::decode(key)));
+        EncodedKey newKey = Traits::encode(index);
+
+        if (!keys.empty() and keys.back() == newKey) {
+            values.back() = std::move(value);
+            return;
+        }
+        keys.push_back(newKey);
+        values.push_back(std::move(value));
+        _noteStoredKey(index);
+    };
+
+    if (_isFrozen)
+        _frozen.visitInOrder(rewrite);
+    else
+        _tree.visitInOrder(rewrite);
+
+    _mapping = KeyMapping();
+
+    if (_isFrozen)
+        _frozen.assign(keys, values);
+    else
+        _tree.assignSorted(keys.begin(), keys.end(), std::make_move_iterator(values.begin()));
+}
+
+
+/**
+ * @param step - A power of two dividing every new index.
+ * @param bound - Largest magnitude of a new index.
+ * @return Returns true if every multiple of step within bound is exactly a Key.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+bool CursedArray<T, Storage, Key>::_foldsExactly(double step, double bound) {
+    return step >= double(std::numeric_limits<Key>::denorm_min())
+           and bound <= double(std::numeric_limits<Key>::max())
+           and bound < std::ldexp(step, std::numeric_limits<Key>::digits - 1);
+}
+
+
+/**
+ * @return Returns the largest power of two dividing a value, or infinity for 0 and non-finite values.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+double CursedArray<T, Storage, Key>::_stepOf(double value) {
+    if (value == 0.0 or !std::isfinite(value))
+        return std::numeric_limits<double>::infinity();
+
+    int exponent;
+    double mantissa = std::frexp(std::fabs(value), &exponent);
+    uint64_t bits = uint64_t(std::ldexp(mantissa, 53));
+    return std::ldexp(double(bits & (~bits + 1)), exponent - 53);
+}
+
+
+/**
+ * Rounds to the nearest Key. Finite values past the Key's range become its largest value.
+ */
+template <typename T, template <typename...> class Storage, typename Key>
+Key CursedArray<T, Storage, Key>::_roundToKey(double value) {
+    const double limit = double(std::numeric_limits<Key>::max());
+    if (std::isfinite(value) and std::fabs(value) > limit)
+        value = std::copysign(limit, value);
+    return Key(value);
+}
+
+
+template <typename T, template <typename...> class Storage, typename Key>
+T* CursedArray<T, Storage, Key>::_get(const Key & index) {
+    Key stored;
+    if (!_mapping.findStored(index, stored))
+        return nullptr;
+
+    EncodedKey key = Traits::encode(stored);
+
+    if (_isFrozen)
+        return _frozen.findValue(key);
+
+    return _tree.findValue(key);
+}
+
+
+template <typename T, template <typename...> class Storage, typename Key>
+template <typename U>
+void CursedArray<T, Storage, Key>::_set(const Key & index, U && value) {
+    if (_isFrozen)
+        thaw();
+
+    _tree.insert_or_assign(_encodeForWrite(index), std::forward<U>(value));
 }
 
 
-#endif //CURSED_ARRAY
\ No newline at end of file
+#endif //CURSED_ARRAY
@@ -10,8 +10,6 @@
 #include <string>
 #include "RedBlack_Tree.h"
 
-// TODO: iterators to find saved keys/values
-
 template<typename T>
 class CursedArray {
 
@@ -30,12 +28,10 @@ public:
     void operator [](int key);    // No int indexes, overloaded to cause an error
     V & operator [](std::string);
 
-    // TODO: addition (++ += +) changes indexKey (RHL = -value to decrease index)
     V & operator ++();
     V & operator +=(float value);
     V & operator +(float value);
 
-    // TODO: subtraction (-- -= -) changes value (RHL = -value to increase value)
     V & operator --();
     V & operator -=(float value);
     V & operator -(float value);
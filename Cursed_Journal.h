@@ -0,0 +1,347 @@
+//   File: Cursed_Journal.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Append-only write-ahead journal of CursedArray mutations.
+//         Mutations are buffered and written as checksummed batches (group
+//         commit), with a configurable fsync policy. A crash can only tear the
+//         last batch, which replay detects by its checksum and ignores.
+//         Layout (native byte order):
+//             JournalHeader
+//             batches: uint32 payloadBytes, uint32 checksum, records...
+//             record:  uint8 op, float index, T value (SET only)
+//         Values must be trivially copyable. File access uses POSIX calls.
+// ---------------------------------------------------------------------
+
+#ifndef CURSED_JOURNAL_H
+#define CURSED_JOURNAL_H
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+enum class FsyncPolicy {
+    NEVER,          // Leave flushing to the OS; survives process crashes, not power loss
+    ON_COMMIT,      // fsync every committed batch
+    INTERVAL        // fsync a committed batch only if the last fsync is older than fsyncIntervalMs
+};
+
+
+struct JournalOptions {
+    FsyncPolicy fsyncPolicy = FsyncPolicy::ON_COMMIT;
+    int fsyncIntervalMs = 100;
+    size_t groupCommitBytes = 64 * 1024;            // Buffered bytes that trigger a commit
+    uint64_t compactionBytes = uint64_t(64) << 20;  // Journal size that triggers a background compaction
+};
+
+
+template <typename T>
+class CursedJournal {
+    static_assert(std::is_trivially_copyable<T>::value, "Journals need a trivially copyable value type");
+
+public:
+    enum : uint8_t { SET = 1, REMOVE = 2 };
+
+private:
+    struct JournalHeader {
+        char magic[8];      // "CURSEDWL"
+        uint32_t version;
+        uint32_t valueSize;
+    };
+
+    static const uint32_t CURRENT_VERSION = 1;
+    static const size_t BATCH_HEADER_BYTES = 2 * sizeof(uint32_t);
+
+    int _descriptor;
+    JournalOptions _options;
+    std::vector<char> _pending;     // Records not yet written
+    uint64_t _bytesWritten;
+    std::chrono::steady_clock::time_point _lastSync;
+
+public:
+    // Constructors
+    CursedJournal();
+    ~CursedJournal();
+    CursedJournal(const CursedJournal &) = delete;
+    CursedJournal & operator =(const CursedJournal &) = delete;
+
+    // Journal Management Methods
+    bool create(const std::string & path, const JournalOptions & options);
+    void close();
+    bool isOpen() const { return _descriptor >= 0; }
+    uint64_t size() const { return _bytesWritten + _pending.size(); }
+
+    // Write Methods
+    bool appendSet(float index, const T & value);
+    bool appendRemove(float index);
+    bool commit();
+
+    // Replay
+    template <typename Apply>
+    static bool replay(const std::string & path, Apply apply);
+
+private:
+    static uint32_t _checksum(const char* bytes, size_t count);
+    static bool _writeAll(int descriptor, const char* bytes, size_t count);
+};
+
+
+// ---------------------------------------------------------------------
+//                          Constructors
+
+/**
+ * Default constructor. Writes nothing until create().
+ */
+template <typename T>
+CursedJournal<T>::CursedJournal() {
+    _descriptor = -1;
+    _bytesWritten = 0;
+}
+
+
+/**
+ * Destructor. Commits any buffered records.
+ */
+template <typename T>
+CursedJournal<T>::~CursedJournal() {
+    close();
+}
+
+
+// ---------------------------------------------------------------------
+//                    Journal Management Methods
+
+/**
+ * Starts a new, empty journal file.
+ * @param path - File to create; it must not already exist.
+ * @param options - Group commit and fsync settings.
+ * @return Returns false if the file cannot be created.
+ */
+template <typename T>
+bool CursedJournal<T>::create(const std::string & path, const JournalOptions & options) {
+    close();
+
+    _descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND, 0644);
+    if (_descriptor < 0)
+        return false;
+
+    JournalHeader header{};
+    std::memcpy(header.magic, "CURSEDWL", 8);
+    header.version = CURRENT_VERSION;
+    header.valueSize = sizeof(T);
+
+    if (!_writeAll(_descriptor, reinterpret_cast<const char*>(&header), sizeof(header)) or ::fsync(_descriptor) != 0) {
+        close();
+        return false;
+    }
+
+    _options = options;
+    _bytesWritten = sizeof(header);
+    _lastSync = std::chrono::steady_clock::now();
+    return true;
+}
+
+
+/**
+ * Commits any buffered records and closes the file.
+ */
+template <typename T>
+void CursedJournal<T>::close() {
+    if (_descriptor < 0)
+        return;
+
+    if (!commit() and _descriptor < 0)
+        return;     // commit() already closed a journal it could not repair
+    ::close(_descriptor);
+    _descriptor = -1;
+    _pending.clear();
+    _bytesWritten = 0;
+}
+
+
+// ---------------------------------------------------------------------
+//                          Write Methods
+
+/**
+ * Buffers a record of an index being set. Commits automatically once the buffer
+ * reaches groupCommitBytes.
+ * @return Returns false if an automatic commit failed.
+ */
+template <typename T>
+bool CursedJournal<T>::appendSet(float index, const T & value) {
+    size_t offset = _pending.size();
+    _pending.resize(offset + 1 + sizeof(float) + sizeof(T));
+
+    _pending[offset] = char(SET);
+    std::memcpy(&_pending[offset + 1], &index, sizeof(float));
+    std::memcpy(&_pending[offset + 1 + sizeof(float)], &value, sizeof(T));
+
+    return _pending.size() < _options.groupCommitBytes or commit();
+}
+
+
+/**
+ * Buffers a record of an index being removed.
+ * @return Returns false if an automatic commit failed.
+ */
+template <typename T>
+bool CursedJournal<T>::appendRemove(float index) {
+    size_t offset = _pending.size();
+    _pending.resize(offset + 1 + sizeof(float));
+
+    _pending[offset] = char(REMOVE);
+    std::memcpy(&_pending[offset + 1], &index, sizeof(float));
+
+    return _pending.size() < _options.groupCommitBytes or commit();
+}
+
+
+/**
+ * Writes every buffered record as one checksummed batch, then fsyncs according to
+ * the policy. Records are durable once this returns true under ON_COMMIT.
+ * A failed write is cut back off the file and its records stay buffered for the next
+ * commit; if the cut fails too, the journal closes rather than append after torn bytes.
+ * @return Returns false if the write or fsync failed.
+ */
+template <typename T>
+bool CursedJournal<T>::commit() {
+    if (_descriptor < 0)
+        return false;
+    if (_pending.empty())
+        return true;
+
+    uint32_t batchHeader[2] = {uint32_t(_pending.size()), _checksum(_pending.data(), _pending.size())};
+    std::vector<char> batch(BATCH_HEADER_BYTES + _pending.size());
+    std::memcpy(batch.data(), batchHeader, BATCH_HEADER_BYTES);
+    std::memcpy(batch.data() + BATCH_HEADER_BYTES, _pending.data(), _pending.size());
+
+    // One write per batch, so a crash tears at most the batch in flight
+    if (!_writeAll(_descriptor, batch.data(), batch.size())) {
+        if (::ftruncate(_descriptor, off_t(_bytesWritten)) != 0) {
+            ::close(_descriptor);
+            _descriptor = -1;
+            _pending.clear();
+            _bytesWritten = 0;
+        }
+        return false;
+    }
+    _bytesWritten += batch.size();
+    _pending.clear();
+
+    auto now = std::chrono::steady_clock::now();
+    bool syncDue = _options.fsyncPolicy == FsyncPolicy::ON_COMMIT
+                   or (_options.fsyncPolicy == FsyncPolicy::INTERVAL
+                       and now - _lastSync >= std::chrono::milliseconds(_options.fsyncIntervalMs));
+    if (!syncDue)
+        return true;
+
+    _lastSync = now;
+    return ::fsync(_descriptor) == 0;
+}
+
+
+// ---------------------------------------------------------------------
+//                             Replay
+
+/**
+ * Reads every intact batch of a journal in order. Stops quietly at a torn or
+ * corrupt batch, which can only be the last one written before a crash.
+ * @param path - Journal file.
+ * @param apply - Called as apply(op, index, const T* value) for each record; value is nullptr for REMOVE.
+ * @return Returns false if the file is missing or is not a journal of this value type.
+ */
+template <typename T>
+template <typename Apply>
+bool CursedJournal<T>::replay(const std::string & path, Apply apply) {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    std::vector<char> contents;
+    char chunk[1 << 16];
+    for (ssize_t bytesRead; (bytesRead = ::read(descriptor, chunk, sizeof(chunk))) > 0; )
+        contents.insert(contents.end(), chunk, chunk + bytesRead);
+    ::close(descriptor);
+
+    JournalHeader header;
+    if (contents.size() < sizeof(header))
+        return false;
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if (std::memcmp(header.magic, "CURSEDWL", 8) != 0 or header.version != CURRENT_VERSION
+        or header.valueSize != sizeof(T))
+        return false;
+
+    size_t position = sizeof(header);
+    while (contents.size() - position >= BATCH_HEADER_BYTES) {
+        uint32_t batchHeader[2];
+        std::memcpy(batchHeader, &contents[position], BATCH_HEADER_BYTES);
+        const char* payload = &contents[position + BATCH_HEADER_BYTES];
+        size_t payloadBytes = batchHeader[0];
+
+        if (contents.size() - position - BATCH_HEADER_BYTES < payloadBytes
+            or _checksum(payload, payloadBytes) != batchHeader[1])
+            break;
+
+        for (size_t offset = 0; offset < payloadBytes; ) {
+            uint8_t op = uint8_t(payload[offset]);
+            float index;
+            std::memcpy(&index, payload + offset + 1, sizeof(float));
+            offset += 1 + sizeof(float);
+
+            if (op == SET) {
+                T value;
+                std::memcpy(&value, payload + offset, sizeof(T));
+                offset += sizeof(T);
+                apply(op, index, &value);
+            } else {
+                apply(op, index, static_cast<const T*>(nullptr));
+            }
+        }
+
+        position += BATCH_HEADER_BYTES + payloadBytes;
+    }
+
+    return true;
+}
+
+
+// ---------------------------------------------------------------------
+//                         Private Methods
+
+/**
+ * 32-bit FNV-1a hash of a byte range.
+ */
+template <typename T>
+uint32_t CursedJournal<T>::_checksum(const char* bytes, size_t count) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < count; ++i) {
+        hash ^= uint8_t(bytes[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+
+template <typename T>
+bool CursedJournal<T>::_writeAll(int descriptor, const char* bytes, size_t count) {
+    while (count > 0) {
+        ssize_t written = ::write(descriptor, bytes, count);
+        if (written < 0 and errno == EINTR)
+            continue;
+        if (written < 0)
+            return false;
+
+        bytes += written;
+        count -= size_t(written);
+    }
+    return true;
+}
+
+
+#endif //CURSED_JOURNAL_H
@@ -0,0 +1,310 @@
+//   File: Cursed_Snapshot.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: On-disk snapshot format for CursedArray, and a read-only memory-mapped view of it.
+//         Layout (native byte order, every section 64-byte aligned):
+//             SnapshotHeader
+//             float keys[count]     strictly ascending by KeyTraits<float> encoding
+//             T values[count]       values[i] belongs to keys[i]
+//         The view searches the mapped keys in place, so opening a snapshot is
+//         O(1) no matter its size. Values must be trivially copyable.
+//         Memory mapping uses POSIX mmap.
+// ---------------------------------------------------------------------
+
+#ifndef CURSED_SNAPSHOT_H
+#define CURSED_SNAPSHOT_H
+
+#include "Key_Traits.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct SnapshotHeader {
+    static const uint32_t CURRENT_VERSION = 1;
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;     // Reads differently on a foreign-endian machine
+    static const uint64_t SECTION_ALIGNMENT = 64;
+
+    char magic[8];          // "CURSEDAR"
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t keySize;
+    uint32_t valueSize;
+    uint64_t count;
+    uint64_t keysOffset;
+    uint64_t valuesOffset;
+    uint64_t fileSize;
+
+    /**
+     * @return Returns a header for count pairs of the given value size, with the section offsets laid out.
+     */
+    static SnapshotHeader describe(uint64_t count, uint32_t valueSize) {
+        SnapshotHeader header{};
+        std::memcpy(header.magic, "CURSEDAR", 8);
+        header.version = CURRENT_VERSION;
+        header.byteOrderMark = BYTE_ORDER_MARK;
+        header.keySize = sizeof(float);
+        header.valueSize = valueSize;
+        header.count = count;
+        header.keysOffset = _align(sizeof(SnapshotHeader));
+        header.valuesOffset = _align(header.keysOffset + count * sizeof(float));
+        header.fileSize = header.valuesOffset + count * valueSize;
+        return header;
+    }
+
+    /**
+     * @return Returns true if the header was written by this format version for this value size,
+     *         and its sections fit in a file of the given size.
+     */
+    bool isValid(uint32_t expectedValueSize, uint64_t actualFileSize) const {
+        if (std::memcmp(magic, "CURSEDAR", 8) != 0 or version != CURRENT_VERSION or byteOrderMark != BYTE_ORDER_MARK)
+            return false;
+        if (keySize != sizeof(float) or valueSize != expectedValueSize)
+            return false;
+
+        SnapshotHeader expected = describe(count, valueSize);
+        return keysOffset == expected.keysOffset and valuesOffset == expected.valuesOffset
+               and fileSize == expected.fileSize and fileSize <= actualFileSize;
+    }
+
+private:
+    static uint64_t _align(uint64_t offset) {
+        return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+    }
+};
+
+
+/**
+ * fsyncs the directory holding a file, making a rename or create of that file durable.
+ * @param path - File whose directory to sync.
+ * @return Returns false if the directory could not be opened or synced.
+ */
+inline bool syncParentDirectory(const std::string & path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "." : (slash == 0) ? "/" : path.substr(0, slash);
+
+    int descriptor = ::open(directory.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    bool synced = ::fsync(descriptor) == 0;
+    ::close(descriptor);
+    return synced;
+}
+
+
+/**
+ * Writes a snapshot from sorted (index, value) pairs.
+ * Writes to path + ".tmp" first, fsyncs it, and renames it over path, so a crash never leaves a
+ * torn snapshot; the directory is then fsynced so the new name survives a crash too.
+ * @param path - File to write.
+ * @param count - Number of pairs.
+ * @param forEachPair - Called as forEachPair(visit) and must call visit(index, value) in ascending index order.
+ * @return Returns true if the snapshot was written.
+ */
+template <typename T, typename ForEachPair>
+bool writeSnapshot(const std::string & path, uint64_t count, ForEachPair forEachPair) {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshots need a trivially copyable value type");
+
+    SnapshotHeader header = SnapshotHeader::describe(count, sizeof(T));
+    std::string tempPath = path + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file)
+        return false;
+
+    static const char padding[SnapshotHeader::SECTION_ALIGNMENT] = {};
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    written = written and std::fwrite(padding, 1, header.keysOffset - sizeof(header), file) == header.keysOffset - sizeof(header);
+
+    // Keys and values are separate sections, so the pairs are walked twice
+    forEachPair([&](const float & key, const T &) {
+        written = written and std::fwrite(&key, sizeof(float), 1, file) == 1;
+    });
+
+    uint64_t keysEnd = header.keysOffset + count * sizeof(float);
+    written = written and std::fwrite(padding, 1, header.valuesOffset - keysEnd, file) == header.valuesOffset - keysEnd;
+
+    forEachPair([&](const float &, const T & value) {
+        written = written and std::fwrite(&value, sizeof(T), 1, file) == 1;
+    });
+
+    // The data must be on disk before the rename can expose it
+    written = written and std::fflush(file) == 0 and ::fsync(::fileno(file)) == 0;
+    written = (std::fclose(file) == 0) and written;
+    if (!written or std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    return syncParentDirectory(path);
+}
+
+
+// ---------------------------------------------------------------------
+//                         MappedCursedArray
+
+/**
+ * Read-only CursedArray backed directly by a memory-mapped snapshot file.
+ * Lookups binary-search the mapped keys; pages are read in by the OS on first touch.
+ */
+template <typename T>
+class MappedCursedArray {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshots need a trivially copyable value type");
+
+private:
+    void* _mapping;
+    size_t _mappedBytes;
+    const float* _keys;
+    const T* _values;
+    int _size;
+
+public:
+    // Constructors
+    MappedCursedArray();
+    ~MappedCursedArray();
+    MappedCursedArray(const MappedCursedArray &) = delete;
+    MappedCursedArray & operator =(const MappedCursedArray &) = delete;
+
+    // Mapping Methods
+    bool open(const std::string & path);
+    void close();
+    bool isOpen() const { return _mapping != nullptr; }
+
+    // Read Methods
+    T operator [](float index) const;
+    const T* findValue(float index) const;
+    int size() const { return _size; }
+    const float* keys() const { return _keys; }
+    const T* values() const { return _values; }
+    template <typename Visitor>
+    void visitInOrder(Visitor visit) const;
+};
+
+
+/**
+ * Default constructor. Maps nothing until open().
+ */
+template <typename T>
+MappedCursedArray<T>::MappedCursedArray() {
+    _mapping = nullptr;
+    _mappedBytes = 0;
+    _keys = nullptr;
+    _values = nullptr;
+    _size = 0;
+}
+
+
+/**
+ * Destructor
+ */
+template <typename T>
+MappedCursedArray<T>::~MappedCursedArray() {
+    close();
+}
+
+
+/**
+ * Maps a snapshot file read-only. Does not read the keys or values.
+ * @param path - Snapshot written by CursedArray::save().
+ * @return Returns false if the file cannot be mapped or is not a snapshot of this value type.
+ */
+template <typename T>
+bool MappedCursedArray<T>::open(const std::string & path) {
+    close();
+
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat fileStatus;
+    if (::fstat(descriptor, &fileStatus) != 0 or size_t(fileStatus.st_size) < sizeof(SnapshotHeader)) {
+        ::close(descriptor);
+        return false;
+    }
+
+    size_t fileBytes = size_t(fileStatus.st_size);
+    void* mapping = ::mmap(nullptr, fileBytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);    // The mapping keeps the file open
+    if (mapping == MAP_FAILED)
+        return false;
+
+    const SnapshotHeader* header = static_cast<const SnapshotHeader*>(mapping);
+    if (!header->isValid(sizeof(T), fileBytes) or header->count > uint64_t(INT32_MAX)) {
+        ::munmap(mapping, fileBytes);
+        return false;
+    }
+
+    _mapping = mapping;
+    _mappedBytes = fileBytes;
+    _keys = reinterpret_cast<const float*>(static_cast<const char*>(mapping) + header->keysOffset);
+    _values = reinterpret_cast<const T*>(static_cast<const char*>(mapping) + header->valuesOffset);
+    _size = int(header->count);
+    return true;
+}
+
+
+/**
+ * Unmaps the snapshot. Pointers from findValue(), keys(), and values() become invalid.
+ */
+template <typename T>
+void MappedCursedArray<T>::close() {
+    if (_mapping)
+        ::munmap(_mapping, _mappedBytes);
+
+    _mapping = nullptr;
+    _mappedBytes = 0;
+    _keys = nullptr;
+    _values = nullptr;
+    _size = 0;
+}
+
+
+/**
+ * @return Returns a copy of the value at an index, or a default value if the index is unset.
+ */
+template <typename T>
+T MappedCursedArray<T>::operator [](float index) const {
+    const T* value = findValue(index);
+    return value ? *value : T();
+}
+
+
+/**
+ * Binary-searches the mapped keys in O(log n), comparing their encodings so NaN
+ * and -0.0 are found where CursedArray put them.
+ * @return Returns a pointer into the mapping, or nullptr if the index is unset.
+ */
+template <typename T>
+const T* MappedCursedArray<T>::findValue(float index) const {
+    using Traits = KeyTraits<float>;
+    auto encodedLess = [](float a, float b) { return Traits::encode(a) < Traits::encode(b); };
+    const float* found = std::lower_bound(_keys, _keys + _size, index, encodedLess);
+
+    if (found == _keys + _size or Traits::encode(*found) != Traits::encode(index))
+        return nullptr;
+
+    return _values + (found - _keys);
+}
+
+
+/**
+ * Visits every (index, value) pair in ascending index order.
+ * @param visit - Called as visit(index, value).
+ */
+template <typename T>
+template <typename Visitor>
+void MappedCursedArray<T>::visitInOrder(Visitor visit) const {
+    for (int i = 0; i < _size; ++i)
+        visit(_keys[i], _values[i]);
+}
+
+
+#endif //CURSED_SNAPSHOT_H
@@ -0,0 +1,137 @@
+//   File: Cursed_Stats.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Opt-in operation counters and latency histograms.
+//         Define CURSED_ARRAY_STATS before including any CursedArray header (or
+//         pass -DCURSED_ARRAY_STATS) to turn them on. Without it, CURSED_STATS()
+//         expands to nothing and the trees carry no stats members, so the
+//         instrumentation costs nothing.
+//         Counters are relaxed atomics, so a monitoring thread can read them
+//         while the owning thread keeps working.
+// ---------------------------------------------------------------------
+
+#ifndef CURSED_STATS_H
+#define CURSED_STATS_H
+
+#ifdef CURSED_ARRAY_STATS
+#define CURSED_STATS(statement) statement
+#else
+#define CURSED_STATS(statement)
+#endif
+
+#ifdef CURSED_ARRAY_STATS
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * Running totals of the work a RedBlackTree has done.
+ * Divide by lookups, inserts, or removes for per-operation averages.
+ */
+struct TreeStats {
+    std::atomic<uint64_t> lookups{0};           // Descents by findValue, insert, cursedInsert, remove
+    std::atomic<uint64_t> comparisons{0};       // Nodes whose key was compared during those descents
+    std::atomic<uint64_t> inserts{0};           // New keys added
+    std::atomic<uint64_t> removes{0};           // Keys removed
+    std::atomic<uint64_t> rotations{0};         // Single rotations while re-balancing
+    std::atomic<uint64_t> recolorings{0};       // Color changes while re-balancing
+
+    void add(std::atomic<uint64_t> & counter, uint64_t amount = 1) {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void report(std::ostream & out) const {
+        uint64_t lookupCount = lookups.load(std::memory_order_relaxed);
+        uint64_t writeCount = inserts.load(std::memory_order_relaxed) + removes.load(std::memory_order_relaxed);
+
+        out << "lookups " << lookupCount
+            << "\ncomparisons_per_lookup " << (lookupCount ? double(comparisons.load()) / double(lookupCount) : 0.0)
+            << "\ninserts " << inserts.load(std::memory_order_relaxed)
+            << "\nremoves " << removes.load(std::memory_order_relaxed)
+            << "\nrotations_per_write " << (writeCount ? double(rotations.load()) / double(writeCount) : 0.0)
+            << "\nrecolorings_per_write " << (writeCount ? double(recolorings.load()) / double(writeCount) : 0.0)
+            << '\n';
+    }
+};
+
+
+/**
+ * Log-scale histogram of latencies. Bucket i counts samples in [2^i, 2^(i+1)) nanoseconds.
+ */
+class LatencyHistogram {
+public:
+    static const int BUCKETS = 40;      // Up to about 18 minutes
+
+private:
+    std::atomic<uint64_t> buckets[BUCKETS] = {};
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> totalNanoseconds{0};
+
+public:
+    void record(uint64_t nanoseconds) {
+        int bucket = 0;
+        while (bucket < BUCKETS - 1 and (nanoseconds >> (bucket + 1)) != 0)
+            ++bucket;
+
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        samples.fetch_add(1, std::memory_order_relaxed);
+        totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return samples.load(std::memory_order_relaxed); }
+    uint64_t bucketCount(int bucket) const { return buckets[bucket].load(std::memory_order_relaxed); }
+
+    double meanNanoseconds() const {
+        uint64_t sampleCount = count();
+        return sampleCount ? double(totalNanoseconds.load(std::memory_order_relaxed)) / double(sampleCount) : 0.0;
+    }
+
+    /**
+     * @param fraction - Percentile as a fraction, e.g. 0.99.
+     * @return Returns the upper edge of the bucket holding that percentile, in nanoseconds.
+     */
+    uint64_t percentileNanoseconds(double fraction) const {
+        uint64_t target = uint64_t(fraction * double(count()));
+        uint64_t seen = 0;
+
+        for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += bucketCount(bucket);
+            if (seen > target)
+                return uint64_t(2) << bucket;
+        }
+        return uint64_t(2) << (BUCKETS - 1);
+    }
+
+    void report(std::ostream & out, const char* name) const {
+        out << name << "_count " << count()
+            << '\n' << name << "_mean_ns " << meanNanoseconds()
+            << '\n' << name << "_p50_ns " << percentileNanoseconds(0.50)
+            << '\n' << name << "_p99_ns " << percentileNanoseconds(0.99)
+            << '\n' << name << "_p999_ns " << percentileNanoseconds(0.999)
+            << '\n';
+    }
+};
+
+
+/**
+ * Records the time from construction to destruction into a histogram.
+ */
+class LatencyTimer {
+    LatencyHistogram & histogram;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit LatencyTimer(LatencyHistogram & histogram)
+        : histogram{histogram}, start{std::chrono::steady_clock::now()} {}
+
+    ~LatencyTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        histogram.record(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+};
+
+#endif // CURSED_ARRAY_STATS
+
+#endif //CURSED_STATS_H
@@ -0,0 +1,421 @@
+//   File: Durable_CursedArray.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: CursedArray whose writes survive crashes.
+//         Every set and remove is appended to a write-ahead journal before it is
+//         applied. On open, the latest snapshot is loaded and the journals written
+//         after it are replayed in one bulk merge. Once a journal grows past
+//         compactionBytes, writes move to a fresh journal and a background thread
+//         snapshots the contents as of the switch, then deletes the older files.
+//         Files share a path prefix and a generation number:
+//             <prefix>.<generation>.snapshot   contents before journal <generation>
+//             <prefix>.<generation>.journal    writes after snapshot <generation>
+//         Not thread-safe; values must be trivially copyable.
+// ---------------------------------------------------------------------
+
+#ifndef DURABLE_CURSED_ARRAY_H
+#define DURABLE_CURSED_ARRAY_H
+
+#include "CursedArray.cpp"
+#include "Cursed_Journal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <typename T, template <typename...> class Storage = RedBlackTree>
+class DurableCursedArray {
+
+private:
+
+    struct Proxy {
+        DurableCursedArray * _ca;
+        float _key;
+    public:
+        Proxy( DurableCursedArray * ca, float key) : _ca(ca), _key(key) {}
+
+        operator T() const {
+            return _ca->get(_key);
+        }
+
+        void operator=(T value) {
+            _ca->set(_key, value);
+        }
+    };
+
+    struct JournalEntry {
+        KeyTraits<float>::encoded_type encodedIndex;    // The order snapshots are written in
+        float index;
+        bool isSet;
+        T value;
+    };
+
+
+    CursedArray<T, Storage> _array;
+    CursedJournal<T> _journal;
+    JournalOptions _options;
+    std::string _prefix;
+    uint64_t _generation = 0;               // Generation of the open journal
+    uint64_t _oldestGeneration = 0;         // Oldest generation that may still have files
+    std::thread _compactor;
+    std::atomic<bool> _compacting{false};
+
+public:
+    // Constructors
+    DurableCursedArray() = default;
+    ~DurableCursedArray();
+    DurableCursedArray(const DurableCursedArray &) = delete;
+    DurableCursedArray & operator =(const DurableCursedArray &) = delete;
+
+    // File Management Methods
+    bool open(const std::string & prefix, const JournalOptions & options = JournalOptions());
+    void close();
+    bool isOpen() const { return _journal.isOpen(); }
+    bool commit();
+    bool compact();
+    void waitForCompaction();
+
+    // Array Methods
+    Proxy operator [](float index) {
+        return Proxy(this, index);
+    }
+
+    T get(float index);
+    bool set(float index, const T & value);
+    bool remove(float index);
+    int size() { return _array.size(); }
+
+    // Read-only access for iteration and searches; writes made through it are not journaled
+    CursedArray<T, Storage> & contents() { return _array; }
+
+private:
+    std::string _path(uint64_t generation, const char* extension) const;
+    bool _recover();
+    bool _startJournal(uint64_t generation);
+    static void _syncPath(const std::string & path);
+};
+
+
+// ---------------------------------------------------------------------
+//                          Constructors
+
+/**
+ * Destructor. Commits buffered writes and waits for any compaction to finish.
+ */
+template <typename T, template <typename...> class Storage>
+DurableCursedArray<T, Storage>::~DurableCursedArray() {
+    close();
+}
+
+
+// ---------------------------------------------------------------------
+//                     File Management Methods
+
+/**
+ * Recovers the contents saved under a path prefix and starts a new journal for writes.
+ * @param prefix - Path prefix of the snapshot and journal files, e.g. "data/prices".
+ * @param options - Group commit, fsync, and compaction settings.
+ * @return Returns false if the directory cannot be read or the journal cannot be created.
+ */
+template <typename T, template <typename...> class Storage>
+bool DurableCursedArray<T, Storage>::open(const std::string & prefix, const JournalOptions & options) {
+    close();
+
+    _prefix = prefix;
+    _options = options;
+    return _recover();
+}
+
+
+/**
+ * Commits buffered writes, closes the journal, and waits for any compaction to finish.
+ * The in-memory contents are kept.
+ */
+template <typename T, template <typename...> class Storage>
+void DurableCursedArray<T, Storage>::close() {
+    _journal.close();
+    waitForCompaction();
+}
+
+
+/**
+ * Writes every buffered record as one batch and fsyncs it according to the policy.
+ * Starts a background compaction if the journal has outgrown compactionBytes.
+ * @return Returns false if the journal could not be written.
+ */
+template <typename T, template <typename...> class Storage>
+bool DurableCursedArray<T, Storage>::commit() {
+    if (!_journal.commit())
+        return false;
+
+    if (_journal.size() >= _options.compactionBytes)
+        compact();
+    return true;
+}
+
+
+/**
+ * Switches writes to a new journal and snapshots the contents as of the switch on a
+ * background thread. The older snapshot and journals are deleted once the new
+ * snapshot is on disk. Does nothing if a compaction is already running.
+ * @return Returns false if a compaction is running or the new journal could not be created.
+ */
+template <typename T, template <typename...> class Storage>
+bool DurableCursedArray<T, Storage>::compact() {
+    if (!_journal.isOpen() or _compacting.load(std::memory_order_acquire))
+        return false;
+    if (_compactor.joinable())
+        _compactor.join();
+
+    if (!_journal.commit() or !_startJournal(_generation + 1))
+        return false;
+
+    // Copy in the foreground so later writes never race the snapshot writer
+    std::vector<float> keys;
+    std::vector<T> values;
+    keys.reserve(_array.size());
+    values.reserve(_array.size());
+    for (auto it = _array.begin(); it != _array.end(); ++it) {
+        keys.push_back(it.key());
+        values.push_back(it.value());
+    }
+
+    _compacting.store(true, std::memory_order_release);
+    _compactor = std::thread([this, oldest = _oldestGeneration, generation = _generation,
+                              keys = std::move(keys), values = std::move(values)]() {
+        std::string snapshotPath = _path(generation, "snapshot");
+        bool written = writeSnapshot<T>(snapshotPath, keys.size(), [&](auto visit) {
+            for (size_t i = 0; i < keys.size(); ++i)
+                visit(keys[i], values[i]);
+        });
+
+        if (written) {
+            // writeSnapshot() made the snapshot durable, and it covers every older file
+            std::error_code error;
+            for (uint64_t old = oldest; old < generation; ++old) {
+                std::filesystem::remove(_path(old, "snapshot"), error);
+                std::filesystem::remove(_path(old, "journal"), error);
+            }
+            _oldestGeneration = generation;     // Read again only after join()
+        }
+
+        _compacting.store(false, std::memory_order_release);
+    });
+
+    return true;
+}
+
+
+/**
+ * Blocks until any background compaction has finished.
+ */
+template <typename T, template <typename...> class Storage>
+void DurableCursedArray<T, Storage>::waitForCompaction() {
+    if (_compactor.joinable())
+        _compactor.join();
+}
+
+
+// ---------------------------------------------------------------------
+//                          Array Methods
+
+/**
+ * @return Returns a copy of the value at an index, or a default value if the index is unset.
+ */
+template <typename T, template <typename...> class Storage>
+T DurableCursedArray<T, Storage>::get(float index) {
+    return _array[index];
+}
+
+
+/**
+ * Applies a write to an index and journals it. The write is durable after the next
+ * commit, which happens on its own once groupCommitBytes of records are buffered.
+ * @return Returns false if the journal is closed or an automatic commit failed; the
+ *         record then stays buffered for the next commit.
+ */
+template <typename T, template <typename...> class Storage>
+bool DurableCursedArray<T, Storage>::set(float index, const T & value) {
+    if (!_journal.isOpen())
+        return false;
+
+    _array[index] = value;
+    bool journaled = _journal.appendSet(index, value);
+
+    if (journaled and _journal.size() >= _options.compactionBytes)
+        compact();
+    return journaled;
+}
+
+
+/**
+ * Removes an index and journals the removal.
+ * @return Returns false if the index was not saved, the journal is closed, or an automatic commit failed.
+ */
+template <typename T, template <typename...> class Storage>
+bool DurableCursedArray<T, Storage>::remove(float index) {
+    if (!_journal.isOpen() or !_array.remove(index))
+        return false;
+
+    bool journaled = _journal.appendRemove(index);
+
+    if (journaled and _journal.size() >= _options.compactionBytes)
+        compact();
+    return journaled;
+}
+
+
+// ---------------------------------------------------------------------
+//                         Private Methods
+
+template <typename T, template <typename...> class Storage>
+std::string DurableCursedArray<T, Storage>::_path(uint64_t generation, const char* extension) const {
+    return _prefix + "." + std::to_string(generation) + "." + extension;
+}
+
+
+/**
+ * Rebuilds the contents from the newest readable snapshot and every journal written
+ * after it. Journal records are sorted by index and merged with the snapshot in one
+ * pass, so replay is O(n + m log m) rather than m separate tree writes.
+ */
+template <typename T, template <typename...> class Storage>
+bool DurableCursedArray<T, Storage>::_recover() {
+    namespace fs = std::filesystem;
+
+    fs::path prefixPath(_prefix);
+    fs::path directory = prefixPath.has_parent_path() ? prefixPath.parent_path() : fs::path(".");
+    std::string stem = prefixPath.filename().string() + ".";
+
+    std::vector<uint64_t> snapshotGenerations;
+    std::vector<uint64_t> journalGenerations;
+    std::error_code error;
+    for (const fs::directory_entry & entry : fs::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.compare(0, stem.size(), stem) != 0)
+            continue;
+
+        std::string rest = name.substr(stem.size());
+        size_t dot = rest.find('.');
+        if (dot == 0 or dot == std::string::npos
+            or rest.find_first_not_of("0123456789") != dot)
+            continue;
+
+        uint64_t generation = std::stoull(rest.substr(0, dot));
+        std::string extension = rest.substr(dot + 1);
+        if (extension == "snapshot")
+            snapshotGenerations.push_back(generation);
+        else if (extension == "journal")
+            journalGenerations.push_back(generation);
+    }
+    if (error)
+        return false;
+
+    std::sort(snapshotGenerations.rbegin(), snapshotGenerations.rend());
+    std::sort(journalGenerations.begin(), journalGenerations.end());
+
+    // Newest snapshot that maps cleanly
+    MappedCursedArray<T> snapshot;
+    uint64_t baseGeneration = 0;
+    for (uint64_t generation : snapshotGenerations) {
+        if (snapshot.open(_path(generation, "snapshot"))) {
+            baseGeneration = generation;
+            break;
+        }
+    }
+
+    std::vector<JournalEntry> entries;
+    for (uint64_t generation : journalGenerations) {
+        if (generation < baseGeneration)
+            continue;
+
+        CursedJournal<T>::replay(_path(generation, "journal"), [&](uint8_t op, float index, const T* value) {
+            entries.push_back({KeyTraits<float>::encode(index), index, op == CursedJournal<T>::SET, value ? *value : T()});
+        });
+    }
+
+    // Keep only the last record per index, then merge it over the snapshot, all by encoding
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const JournalEntry & a, const JournalEntry & b) { return a.encodedIndex < b.encodedIndex; });
+    auto snapshotKey = [&](int i) { return KeyTraits<float>::encode(snapshot.keys()[i]); };
+
+    std::vector<float> keys;
+    std::vector<T> values;
+    keys.reserve(size_t(snapshot.size()) + entries.size());
+    values.reserve(size_t(snapshot.size()) + entries.size());
+
+    int snapshotIndex = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (i + 1 < entries.size() and entries[i].encodedIndex == entries[i + 1].encodedIndex)
+            continue;   // A later record for the same index wins
+
+        const JournalEntry & entry = entries[i];
+        for (; snapshotIndex < snapshot.size() and snapshotKey(snapshotIndex) < entry.encodedIndex; ++snapshotIndex) {
+            keys.push_back(snapshot.keys()[snapshotIndex]);
+            values.push_back(snapshot.values()[snapshotIndex]);
+        }
+        if (snapshotIndex < snapshot.size() and snapshotKey(snapshotIndex) == entry.encodedIndex)
+            ++snapshotIndex;    // Replaced or removed by the journal
+
+        if (entry.isSet) {
+            keys.push_back(entry.index);
+            values.push_back(entry.value);
+        }
+    }
+    for (; snapshotIndex < snapshot.size(); ++snapshotIndex) {
+        keys.push_back(snapshot.keys()[snapshotIndex]);
+        values.push_back(snapshot.values()[snapshotIndex]);
+    }
+
+    _array.assignSorted(keys.begin(), keys.end(), values.begin());
+
+    _oldestGeneration = 0;
+    if (!snapshotGenerations.empty())
+        _oldestGeneration = snapshotGenerations.back();
+    if (!journalGenerations.empty())
+        _oldestGeneration = std::min(_oldestGeneration, journalGenerations.front());
+
+    // Never append to an old journal; its tail may be torn
+    uint64_t nextGeneration = baseGeneration;
+    if (!journalGenerations.empty())
+        nextGeneration = std::max(nextGeneration, journalGenerations.back() + 1);
+    if (!snapshotGenerations.empty())
+        nextGeneration = std::max(nextGeneration, snapshotGenerations.front() + 1);
+    return _startJournal(nextGeneration);
+}
+
+
+template <typename T, template <typename...> class Storage>
+bool DurableCursedArray<T, Storage>::_startJournal(uint64_t generation) {
+    if (!_journal.create(_path(generation, "journal"), _options))
+        return false;
+
+    _generation = generation;
+    if (_options.fsyncPolicy != FsyncPolicy::NEVER) {
+        std::filesystem::path parent = std::filesystem::path(_prefix).parent_path();
+        _syncPath(parent.empty() ? "." : parent.string());    // Make the new file's name durable
+    }
+    return true;
+}
+
+
+/**
+ * fsyncs a file or directory by path.
+ */
+template <typename T, template <typename...> class Storage>
+void DurableCursedArray<T, Storage>::_syncPath(const std::string & path) {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return;
+
+    ::fsync(descriptor);
+    ::close(descriptor);
+}
+
+
+#endif //DURABLE_CURSED_ARRAY_H
@@ -0,0 +1,463 @@
+//   File: Frozen_Array.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Read-only sorted array declarations and definitions.
+//         Keys are stored in Eytzinger (breadth-first) order so a search walks
+//         an implicit balanced tree laid out in one contiguous block.
+// ---------------------------------------------------------------------
+
+#ifndef FROZENARRAY_H
+#define FROZENARRAY_H
+
+#include "Key_Traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+template <typename K, typename V, typename Compare = KeyCompare<K>>
+class FrozenArray {
+private:
+    // Index 0 is unused so node i has children 2i and 2i + 1
+    std::vector<K> keys;
+    std::vector<V> values;     // Parallel to keys
+    int _size;
+
+public:
+    // Bidirectional in-order iterator over the layout. Dereferences to the value;
+    // key() gives the key.
+    class iterator {
+        friend class FrozenArray;
+        FrozenArray* _array;
+        int _index;     // 0 for end()
+
+        iterator(FrozenArray* array, int index) : _array{array}, _index{index} {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = V;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        iterator() : _array{nullptr}, _index{0} {}
+
+        const K & key() const { return _array->keys[_index]; }
+        V & value() const { return _array->values[_index]; }
+        V & operator*() const { return _array->values[_index]; }
+        V * operator->() const { return &_array->values[_index]; }
+
+        iterator & operator++() {
+            _index = _array->_successor(_index);
+            return *this;
+        }
+        iterator & operator--() {
+            _index = _array->_predecessor(_index);
+            return *this;
+        }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        iterator operator--(int) { iterator old = *this; --*this; return old; }
+
+        bool operator==(const iterator & other) const { return _index == other._index; }
+        bool operator!=(const iterator & other) const { return _index != other._index; }
+    };
+
+    // Constructors
+    FrozenArray();
+
+    // Array Management Methods
+    void assign(const std::vector<K> & sortedKeys, std::vector<V> & sortedValues);
+    V* findValue(const K & key);
+    int size();
+    void clear();
+
+    // Traversal Methods
+    template <typename Visitor>
+    void visitInOrder(Visitor visit);
+
+    // Iterator Methods
+    iterator begin();
+    iterator end();
+    iterator lower_bound(const K & key);
+    iterator upper_bound(const K & key);
+
+    // Range Query Methods
+    iterator floor(const K & key);
+    iterator ceil(const K & key);
+
+    // Order Statistic Methods
+    int rank(const K & key);
+    iterator select(int position);
+
+private:
+    template <bool IncludeEqual>
+    int _searchIndex(const K & key);
+    int _firstIndex();
+    int _lastIndex();
+    int _successor(int index);
+    int _predecessor(int index);
+    int _subtreeSize(int index);
+    void _layout(const std::vector<K> & sortedKeys, std::vector<V> & sortedValues, int & nextSorted, int index);
+};
+
+
+// ---------------------------------------------------------------------
+//                          Constructors
+
+/**
+ * Default constructor
+ */
+template <typename K, typename V, typename Compare>
+FrozenArray<K,V,Compare>::FrozenArray() {
+    _size = 0;
+}
+
+
+// ---------------------------------------------------------------------
+//                  Public Array Management Methods
+
+/**
+ * Replaces the contents with sorted (key, value) pairs.
+ * @param sortedKeys - Keys in ascending order with no duplicates.
+ * @param sortedValues - Values matching sortedKeys. Values are moved out.
+ */
+template <typename K, typename V, typename Compare>
+void FrozenArray<K,V,Compare>::assign(const std::vector<K> & sortedKeys, std::vector<V> & sortedValues) {
+    _size = int(sortedKeys.size());
+    keys.assign(_size + 1, K());
+    values.clear();
+    values.resize(_size + 1);   // Default-constructed in place, so V may be move-only
+
+    int nextSorted = 0;
+    _layout(sortedKeys, sortedValues, nextSorted, 1);
+}
+
+
+/**
+ * Finds the value stored at a key.
+ * @param key (K) - Key to find.
+ * @return - Returns a pointer to the value stored at a key, or nullptr if the key is not in the array.
+ */
+template <typename K, typename V, typename Compare>
+V* FrozenArray<K,V,Compare>::findValue(const K & key) {
+    int index = _searchIndex<false>(key);
+
+    if (index == 0 or Compare::compare(keys[index], key) != 0)
+        return nullptr;
+
+    return &values[index];
+
+} // End findValue()
+
+
+/**
+ * @return Returns the number of keys in the array.
+ */
+template <typename K, typename V, typename Compare>
+inline int FrozenArray<K,V,Compare>::size() {
+    return _size;
+}
+
+
+/**
+ * Removes every key and releases the array storage.
+ */
+template <typename K, typename V, typename Compare>
+void FrozenArray<K,V,Compare>::clear() {
+    std::vector<K>().swap(keys);
+    std::vector<V>().swap(values);
+    _size = 0;
+}
+
+
+// ---------------------------------------------------------------------
+//                       Public Traversal Methods
+
+/**
+ * Visits every (key, value) pair in ascending key order.
+ * @param visit - Called as visit(key, value).
+ */
+template <typename K, typename V, typename Compare>
+template <typename Visitor>
+void FrozenArray<K,V,Compare>::visitInOrder(Visitor visit) {
+    for (int index = _firstIndex(); index != 0; index = _successor(index))
+        visit(keys[index], values[index]);
+}
+
+
+// ---------------------------------------------------------------------
+//                        Public Iterator Methods
+
+/**
+ * @return Returns an iterator to the smallest key, or end() if the array is empty.
+ */
+template <typename K, typename V, typename Compare>
+typename FrozenArray<K,V,Compare>::iterator FrozenArray<K,V,Compare>::begin() {
+    return iterator(this, _firstIndex());
+}
+
+
+/**
+ * @return Returns the past-the-end iterator.
+ */
+template <typename K, typename V, typename Compare>
+typename FrozenArray<K,V,Compare>::iterator FrozenArray<K,V,Compare>::end() {
+    return iterator(this, 0);
+}
+
+
+/**
+ * @param key - Key to search for.
+ * @return Returns an iterator to the first key >= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename FrozenArray<K,V,Compare>::iterator FrozenArray<K,V,Compare>::lower_bound(const K & key) {
+    return iterator(this, _searchIndex<false>(key));
+}
+
+
+/**
+ * @param key - Key to search for.
+ * @return Returns an iterator to the first key > key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename FrozenArray<K,V,Compare>::iterator FrozenArray<K,V,Compare>::upper_bound(const K & key) {
+    return iterator(this, _searchIndex<true>(key));
+}
+
+
+// ---------------------------------------------------------------------
+//                       Public Range Query Methods
+
+/**
+ * @return Returns an iterator to the largest key <= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename FrozenArray<K,V,Compare>::iterator FrozenArray<K,V,Compare>::floor(const K & key) {
+    return iterator(this, _predecessor(_searchIndex<true>(key)));
+}
+
+
+/**
+ * @return Returns an iterator to the smallest key >= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename FrozenArray<K,V,Compare>::iterator FrozenArray<K,V,Compare>::ceil(const K & key) {
+    return lower_bound(key);
+}
+
+
+// ---------------------------------------------------------------------
+//                     Public Order Statistic Methods
+//      Subtree sizes of the implicit tree are computed from its shape, so no
+//      per-key counts are stored and each query costs O(log^2 n).
+
+/**
+ * @param key - Key to rank. Does not need to be in the array.
+ * @return Returns the number of keys < key.
+ */
+template <typename K, typename V, typename Compare>
+int FrozenArray<K,V,Compare>::rank(const K & key) {
+    int keysBelow = 0;
+    int index = 1;
+
+    while (index <= _size) {
+        if (Compare::compare(keys[index], key) < 0) {
+            keysBelow += _subtreeSize(2 * index) + 1;
+            index = 2 * index + 1;
+        } else {
+            index = 2 * index;
+        }
+    }
+
+    return keysBelow;
+}
+
+
+/**
+ * @param position - 0 for the smallest key, size() - 1 for the largest.
+ * @return Returns an iterator to the key at a position in sorted order, or end() if out of range.
+ */
+template <typename K, typename V, typename Compare>
+typename FrozenArray<K,V,Compare>::iterator FrozenArray<K,V,Compare>::select(int position) {
+    if (position < 0 or position >= _size)
+        return end();
+
+    int index = 1;
+
+    while (true) {
+        int leftSize = _subtreeSize(2 * index);
+
+        if (position == leftSize)
+            return iterator(this, index);
+
+        if (position < leftSize) {
+            index = 2 * index;
+        } else {
+            position -= leftSize + 1;
+            index = 2 * index + 1;
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------
+//                     Private Array Management Methods
+
+/**
+ * Recursive in-order fill of the Eytzinger layout.
+ * @param index - Node of the implicit tree to fill.
+ */
+template <typename K, typename V, typename Compare>
+void FrozenArray<K,V,Compare>::_layout(const std::vector<K> & sortedKeys, std::vector<V> & sortedValues,
+                               int & nextSorted, int index) {
+    if (index > _size)
+        return;
+
+    _layout(sortedKeys, sortedValues, nextSorted, 2 * index);
+
+    keys[index] = sortedKeys[nextSorted];
+    values[index] = std::move(sortedValues[nextSorted]);
+    ++nextSorted;
+
+    _layout(sortedKeys, sortedValues, nextSorted, 2 * index + 1);
+}
+
+
+/**
+ * Branch-free descent of the implicit tree.
+ * Each step picks a child with arithmetic, and the bound is recovered from the
+ * final index afterward by undoing the trailing right turns plus the last left turn.
+ * @tparam IncludeEqual - False for the first key >= key, true for the first key > key.
+ * @param key - Key to search for.
+ * @return Returns the index of the bound, or 0 if every key is smaller.
+ */
+template <typename K, typename V, typename Compare>
+template <bool IncludeEqual>
+int FrozenArray<K,V,Compare>::_searchIndex(const K & key) {
+    const K* keyData = keys.data();
+    int index = 1;
+
+    while (index <= _size) {
+#if defined(__GNUC__)
+        // Great-great-grandchildren share a cache line; clamped so the pointer stays inside the array
+        __builtin_prefetch(keyData + std::min(16 * size_t(index), size_t(_size)));
+#endif
+        if (IncludeEqual)
+            index = 2 * index + (Compare::compare(keyData[index], key) <= 0);
+        else
+            index = 2 * index + (Compare::compare(keyData[index], key) < 0);
+    }
+
+#if defined(__GNUC__)
+    index >>= __builtin_ffs(~index);
+#else
+    while (index & 1)
+        index >>= 1;
+    index >>= 1;
+#endif
+
+    return index;
+}
+
+
+/**
+ * @return Returns the index of the smallest key, or 0 if the array is empty.
+ */
+template <typename K, typename V, typename Compare>
+int FrozenArray<K,V,Compare>::_firstIndex() {
+    if (_size == 0)
+        return 0;
+
+    int index = 1;
+    while (2 * index <= _size)
+        index *= 2;
+
+    return index;
+}
+
+
+/**
+ * @return Returns the index of the largest key, or 0 if the array is empty.
+ */
+template <typename K, typename V, typename Compare>
+int FrozenArray<K,V,Compare>::_lastIndex() {
+    if (_size == 0)
+        return 0;
+
+    int index = 1;
+    while (2 * index + 1 <= _size)
+        index = 2 * index + 1;
+
+    return index;
+}
+
+
+/**
+ * @return Returns the index of the next key in order, or 0 after the largest key.
+ */
+template <typename K, typename V, typename Compare>
+int FrozenArray<K,V,Compare>::_successor(int index) {
+    if (2 * index + 1 <= _size) {
+        // Successor is the leftmost node of the right subtree
+        index = 2 * index + 1;
+        while (2 * index <= _size)
+            index *= 2;
+        return index;
+    }
+
+    // Climb while we are a right child, then once more
+    while (index & 1)
+        index >>= 1;
+
+    return index >> 1;
+}
+
+
+/**
+ * @return Returns the index of the previous key in order, or 0 before the smallest key.
+ *         Stepping back from 0 (end) gives the largest key.
+ */
+template <typename K, typename V, typename Compare>
+int FrozenArray<K,V,Compare>::_predecessor(int index) {
+    if (index == 0)
+        return _lastIndex();
+
+    if (2 * index <= _size) {
+        // Predecessor is the rightmost node of the left subtree
+        index = 2 * index;
+        while (2 * index + 1 <= _size)
+            index = 2 * index + 1;
+        return index;
+    }
+
+    // Climb while we are a left child, then once more
+    while (index > 1 and !(index & 1))
+        index >>= 1;
+
+    return index >> 1;
+}
+
+
+/**
+ * Counts the nodes in the implicit subtree rooted at an index, one level at a time.
+ * @return Returns the subtree size, or 0 if the index is past the end.
+ */
+template <typename K, typename V, typename Compare>
+int FrozenArray<K,V,Compare>::_subtreeSize(int index) {
+    int count = 0;
+    long long levelFirst = index;
+    long long levelLast = index;
+
+    while (levelFirst <= _size) {
+        count += int(std::min<long long>(levelLast, _size) - levelFirst + 1);
+        levelFirst = 2 * levelFirst;
+        levelLast = 2 * levelLast + 1;
+    }
+
+    return count;
+}
+
+
+#endif //FROZENARRAY_H
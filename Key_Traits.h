@@ -0,0 +1,205 @@
+//   File: Key_Traits.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Key comparators and encodings chosen at compile time.
+//         KeyCompare<K> gives the trees one three-way compare per node: a
+//         branch-free one for integers, std::string::compare for strings, and
+//         operator< otherwise. Specialize it for a key type to change its order.
+//         KeyTraits<K> maps a CursedArray index to the key the trees store.
+//         Floats and doubles become order-preserving unsigned integers, which
+//         gives every key, NaN included, a place in a total order:
+//             -inf < ... < -0.0 == +0.0 < ... < +inf < NaN
+//         -0.0 is stored as +0.0 and every NaN as one quiet NaN, so they still
+//         name the same index. FixedPoint keys are stored as their raw integer.
+//         Other key types pass through unchanged.
+// ---------------------------------------------------------------------
+
+#ifndef KEY_TRAITS_H
+#define KEY_TRAITS_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// ---------------------------------------------------------------------
+//                            Comparators
+
+/**
+ * Three-way compare from operator<: negative if a < b, zero if equal, positive if a > b.
+ */
+template <typename K, typename Enable = void>
+struct KeyCompare {
+    static constexpr int compare(const K & a, const K & b) {
+        return (a < b) ? -1 : (b < a);
+    }
+};
+
+
+/**
+ * Integers (and encoded floats) compare without branches.
+ */
+template <typename K>
+struct KeyCompare<K, typename std::enable_if<std::is_integral<K>::value>::type> {
+    static constexpr int compare(K a, K b) {
+        return int(a > b) - int(a < b);
+    }
+};
+
+
+/**
+ * Strings compare in one pass over their characters instead of two.
+ */
+template <>
+struct KeyCompare<std::string> {
+    static int compare(const std::string & a, const std::string & b) {
+        return a.compare(b);
+    }
+};
+
+
+// ---------------------------------------------------------------------
+//                         Fixed-Point Keys
+
+/**
+ * A signed fixed-point number with FractionBits bits after the binary point, e.g.
+ * FixedPoint<int64_t, 32> for timestamps with sub-nanosecond steps and no float
+ * rounding. Stored and compared as a plain integer.
+ */
+template <typename Integer, int FractionBits>
+struct FixedPoint {
+    static_assert(std::is_integral<Integer>::value and std::is_signed<Integer>::value, "Needs a signed integer");
+    static_assert(FractionBits >= 0 and FractionBits < int(sizeof(Integer) * 8) - 1, "Too many fraction bits");
+
+    static constexpr double SCALE = double(Integer(1) << FractionBits);
+
+    Integer raw = 0;
+
+    FixedPoint() = default;
+    static constexpr FixedPoint fromRaw(Integer raw) { FixedPoint fixed; fixed.raw = raw; return fixed; }
+    explicit FixedPoint(double value) : raw{Integer(value * SCALE + (value < 0 ? -0.5 : 0.5))} {}
+
+    double toDouble() const { return double(raw) / SCALE; }
+
+    friend FixedPoint operator +(FixedPoint a, FixedPoint b) { return fromRaw(a.raw + b.raw); }
+    friend FixedPoint operator -(FixedPoint a, FixedPoint b) { return fromRaw(a.raw - b.raw); }
+    friend bool operator <(FixedPoint a, FixedPoint b) { return a.raw < b.raw; }
+    friend bool operator ==(FixedPoint a, FixedPoint b) { return a.raw == b.raw; }
+    friend bool operator !=(FixedPoint a, FixedPoint b) { return a.raw != b.raw; }
+};
+
+
+template <typename K>
+struct IsFixedPoint : std::false_type {};
+
+template <typename Integer, int FractionBits>
+struct IsFixedPoint<FixedPoint<Integer, FractionBits>> : std::true_type {};
+
+
+// ---------------------------------------------------------------------
+//                             Encodings
+
+/**
+ * Identity encoding for keys that already compare correctly.
+ */
+template <typename K>
+struct KeyTraits {
+    using encoded_type = K;
+
+    static const encoded_type & encode(const K & key) { return key; }
+    static const K & decode(const encoded_type & encoded) { return encoded; }
+};
+
+
+/**
+ * Shared encoding for IEEE-754 floats: flip every bit of a negative value and only
+ * the sign bit of a positive one, so unsigned order matches numeric order.
+ */
+template <typename F, typename U>
+struct FloatKeyTraits {
+    static_assert(sizeof(F) == sizeof(U) and std::numeric_limits<F>::is_iec559, "Needs an IEEE-754 float");
+
+    using encoded_type = U;
+    static constexpr U SIGN_BIT = U(1) << (sizeof(U) * 8 - 1);
+
+    static encoded_type encode(F key) {
+        if (key == F(0))
+            key = F(0);     // -0.0 becomes +0.0
+        else if (key != key)
+            key = std::numeric_limits<F>::quiet_NaN();
+
+        U bits;
+        std::memcpy(&bits, &key, sizeof(U));
+        return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+    }
+
+    static F decode(encoded_type encoded) {
+        U bits = (encoded & SIGN_BIT) ? (encoded & ~SIGN_BIT) : ~encoded;
+
+        F key;
+        std::memcpy(&key, &bits, sizeof(U));
+        return key;
+    }
+};
+
+template <>
+struct KeyTraits<float> : FloatKeyTraits<float, uint32_t> {};
+
+template <>
+struct KeyTraits<double> : FloatKeyTraits<double, uint64_t> {};
+
+
+/**
+ * Fixed-point keys are stored as their raw integer, so the trees use the integer compare.
+ */
+template <typename Integer, int FractionBits>
+struct KeyTraits<FixedPoint<Integer, FractionBits>> {
+    using encoded_type = Integer;
+
+    static encoded_type encode(FixedPoint<Integer, FractionBits> key) { return key.raw; }
+    static FixedPoint<Integer, FractionBits> decode(encoded_type encoded) {
+        return FixedPoint<Integer, FractionBits>::fromRaw(encoded);
+    }
+};
+
+
+/**
+ * Stable LSD radix sort of positions by unsigned key, one byte per pass, in O(n).
+ * Passes whose byte is the same for every key are skipped.
+ * @param keys - Unsigned integer keys.
+ * @return Returns the positions of keys in ascending key order; equal keys keep their input order.
+ */
+template <typename U>
+std::vector<int> radixSortOrder(const std::vector<U> & keys) {
+    static_assert(std::is_unsigned<U>::value, "Radix sort needs unsigned keys");
+
+    std::vector<int> order(keys.size());
+    std::vector<int> scratch(keys.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = int(i);
+
+    for (unsigned shift = 0; shift < sizeof(U) * 8; shift += 8) {
+        size_t counts[257] = {};
+        for (const U & key : keys)
+            ++counts[((key >> shift) & 0xFF) + 1];
+
+        bool oneBucket = false;
+        for (int digit = 1; digit <= 256; ++digit)
+            oneBucket = oneBucket or counts[digit] == keys.size();
+        if (oneBucket)
+            continue;
+
+        for (int digit = 1; digit <= 256; ++digit)
+            counts[digit] += counts[digit - 1];
+        for (int position : order)
+            scratch[counts[(keys[position] >> shift) & 0xFF]++] = position;
+        order.swap(scratch);
+    }
+
+    return order;
+}
+
+
+#endif //KEY_TRAITS_H
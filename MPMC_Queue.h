@@ -0,0 +1,363 @@
+//   File: MPMC_Queue.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Lock-free bounded multi-producer/multi-consumer queue.
+//         A power-of-two ring of cells, each tagged with a sequence number that
+//         says whether the cell is ready for the next producer or consumer of
+//         its position. Threads claim positions with one compare-exchange on a
+//         shared counter and never block each other while copying data.
+//         Contains MPMCQueue declarations and definitions (due to templating).
+// ---------------------------------------------------------------------
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <thread>
+#include <utility>
+
+template <typename T>
+class MPMCQueue {
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;   // position: free for that enqueue; position + 1: holds its value
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    static const int SPINS_BEFORE_YIELD = 64;
+
+    Cell* cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePosition;    // Separate cache lines so producers
+    alignas(64) std::atomic<size_t> dequePosition;      // and consumers do not share one
+
+public:
+    // Constructors
+    explicit MPMCQueue(size_t minCapacity = 1024);
+    ~MPMCQueue();
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue & operator =(const MPMCQueue &) = delete;
+
+    // Non-blocking Methods
+    bool tryEnqueue(const T & data);
+    bool tryEnqueue(T && data);
+    bool tryDeque(T & dataOut);
+    template <typename InputIt>
+    int tryEnqueueBatch(InputIt first, int count);
+    template <typename OutputIt>
+    int tryDequeBatch(OutputIt out, int maxCount);
+
+    // Blocking Methods
+    void enqueue(const T & data);
+    void enqueue(T && data);
+    T deque();
+    template <typename InputIt>
+    void enqueueBatch(InputIt first, int count);
+    template <typename OutputIt>
+    int dequeBatch(OutputIt out, int maxCount);
+
+    // Accessors
+    size_t capacity() const;
+    size_t sizeApprox() const;
+
+private:
+    template <typename U>
+    bool _tryEnqueue(U && data);
+    size_t _claim(std::atomic<size_t> & counter, size_t readyOffset, size_t maxCount, size_t & position);
+    static void _backOff(int & spins);
+};
+
+
+// -----------------------------------------------------------------------------
+// Function Definitions
+// -----------------------------------------------------------------------------
+
+/**
+ * @param minCapacity - Fewest elements the queue must hold; rounded up to a power of two.
+ */
+template <typename T>
+MPMCQueue<T>::MPMCQueue(size_t minCapacity) : enqueuePosition{0}, dequePosition{0} {
+    size_t size = 2;
+    while (size < minCapacity)
+        size *= 2;
+
+    cells = static_cast<Cell*>(::operator new(sizeof(Cell) * size));
+    for (size_t i = 0; i < size; ++i)
+        new (&cells[i].sequence) std::atomic<size_t>(i);
+    mask = size - 1;
+}
+
+
+/**
+ * Destructor. No other thread may be using the queue.
+ */
+template <typename T>
+MPMCQueue<T>::~MPMCQueue() {
+    size_t last = enqueuePosition.load(std::memory_order_relaxed);
+
+    for (size_t position = dequePosition.load(std::memory_order_relaxed); position != last; ++position)
+        cells[position & mask].value()->~T();
+
+    ::operator delete(cells);
+}
+
+
+// ---------------------------------------------------------------------
+//                       Non-blocking Methods
+
+/**
+ * @param data - Value to add at the back of the queue.
+ * @return Returns false, leaving data untouched, if the queue is full.
+ */
+template <typename T>
+bool MPMCQueue<T>::tryEnqueue(const T & data) {
+    return _tryEnqueue(data);
+}
+
+
+template <typename T>
+bool MPMCQueue<T>::tryEnqueue(T && data) {
+    return _tryEnqueue(std::move(data));
+}
+
+
+/**
+ * @param dataOut - Receives the front value, moved out of the queue.
+ * @return Returns false if the queue is empty.
+ */
+template <typename T>
+bool MPMCQueue<T>::tryDeque(T & dataOut) {
+    return tryDequeBatch(&dataOut, 1) == 1;
+}
+
+
+/**
+ * Enqueues as many of the next count values as fit, claiming all their cells with
+ * one compare-exchange so they stay contiguous in queue order.
+ * @param first - Start of the values; each enqueued value is moved from.
+ * @param count - Number of values offered.
+ * @return Returns how many values were enqueued, taken from the front of the range.
+ */
+template <typename T>
+template <typename InputIt>
+int MPMCQueue<T>::tryEnqueueBatch(InputIt first, int count) {
+    if (count <= 0)
+        return 0;
+
+    size_t position;
+    size_t claimed = _claim(enqueuePosition, 0, size_t(count), position);
+
+    for (size_t i = 0; i < claimed; ++i, ++position, ++first) {
+        Cell & cell = cells[position & mask];
+        new (cell.storage) T(std::move(*first));
+        cell.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    return int(claimed);
+}
+
+
+/**
+ * Deques up to maxCount values, claiming all their cells with one compare-exchange.
+ * @param out - Receives the values in queue order.
+ * @param maxCount - Most values to take.
+ * @return Returns how many values were dequed.
+ */
+template <typename T>
+template <typename OutputIt>
+int MPMCQueue<T>::tryDequeBatch(OutputIt out, int maxCount) {
+    if (maxCount <= 0)
+        return 0;
+
+    size_t position;
+    size_t claimed = _claim(dequePosition, 1, size_t(maxCount), position);
+
+    for (size_t i = 0; i < claimed; ++i, ++position, ++out) {
+        Cell & cell = cells[position & mask];
+        *out = std::move(*cell.value());
+        cell.value()->~T();
+        cell.sequence.store(position + mask + 1, std::memory_order_release);   // Free for the next lap
+    }
+
+    return int(claimed);
+}
+
+
+// ---------------------------------------------------------------------
+//                         Blocking Methods
+
+/**
+ * Adds a value at the back of the queue, waiting while the queue is full.
+ * @param data - Value to add.
+ */
+template <typename T>
+void MPMCQueue<T>::enqueue(const T & data) {
+    for (int spins = 0; !_tryEnqueue(data); )
+        _backOff(spins);
+}
+
+
+template <typename T>
+void MPMCQueue<T>::enqueue(T && data) {
+    for (int spins = 0; !_tryEnqueue(std::move(data)); )
+        _backOff(spins);
+}
+
+
+/**
+ * Removes the front value, waiting while the queue is empty.
+ * @return Returns the removed value.
+ */
+template <typename T>
+T MPMCQueue<T>::deque() {
+    size_t position;
+    for (int spins = 0; _claim(dequePosition, 1, 1, position) == 0; )
+        _backOff(spins);
+
+    Cell & cell = cells[position & mask];
+    T value = std::move(*cell.value());
+    cell.value()->~T();
+    cell.sequence.store(position + mask + 1, std::memory_order_release);
+
+    return value;
+}
+
+
+/**
+ * Enqueues all count values, waiting for room as needed. Values from one call stay
+ * in order but may interleave with other producers' values when the queue fills.
+ * @param first - Start of the values; each is moved from.
+ * @param count - Number of values.
+ */
+template <typename T>
+template <typename InputIt>
+void MPMCQueue<T>::enqueueBatch(InputIt first, int count) {
+    int spins = 0;
+
+    while (count > 0) {
+        int added = tryEnqueueBatch(first, count);
+        if (added == 0) {
+            _backOff(spins);
+            continue;
+        }
+
+        std::advance(first, added);
+        count -= added;
+        spins = 0;
+    }
+}
+
+
+/**
+ * Waits until the queue has values, then deques up to maxCount of them.
+ * @param out - Receives the values in queue order.
+ * @param maxCount - Most values to take.
+ * @return Returns how many values were dequed (at least one).
+ */
+template <typename T>
+template <typename OutputIt>
+int MPMCQueue<T>::dequeBatch(OutputIt out, int maxCount) {
+    int taken;
+    for (int spins = 0; (taken = tryDequeBatch(out, maxCount)) == 0 and maxCount > 0; )
+        _backOff(spins);
+
+    return taken;
+}
+
+
+// ---------------------------------------------------------------------
+//                            Accessors
+
+template <typename T>
+inline size_t MPMCQueue<T>::capacity() const {
+    return mask + 1;
+}
+
+
+/**
+ * @return Returns the number of values queued, which may already be stale when other threads are active.
+ */
+template <typename T>
+size_t MPMCQueue<T>::sizeApprox() const {
+    size_t dequed = dequePosition.load(std::memory_order_relaxed);
+    size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+
+    return (enqueued > dequed) ? enqueued - dequed : 0;
+}
+
+
+// ---------------------------------------------------------------------
+//                         Private Methods
+
+template <typename T>
+template <typename U>
+bool MPMCQueue<T>::_tryEnqueue(U && data) {
+    size_t position;
+    if (_claim(enqueuePosition, 0, 1, position) == 0)
+        return false;
+
+    Cell & cell = cells[position & mask];
+    new (cell.storage) T(std::forward<U>(data));
+    cell.sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+/**
+ * Claims up to maxCount consecutive positions from a producer or consumer counter.
+ * A cell is ready for position p when its sequence is p + readyOffset (0 for producers,
+ * 1 for consumers); the claim stops at the first cell that is not.
+ * @param counter - enqueuePosition or dequePosition.
+ * @param position - Receives the first claimed position.
+ * @return Returns the number of positions claimed, 0 if the queue is full (producers) or empty (consumers).
+ */
+template <typename T>
+size_t MPMCQueue<T>::_claim(std::atomic<size_t> & counter, size_t readyOffset, size_t maxCount, size_t & position) {
+    position = counter.load(std::memory_order_relaxed);
+
+    while (true) {
+        size_t ready = 0;
+        intptr_t lag = 0;
+
+        for (; ready < maxCount; ++ready) {
+            size_t sequence = cells[(position + ready) & mask].sequence.load(std::memory_order_acquire);
+            lag = intptr_t(sequence - (position + ready + readyOffset));
+            if (lag != 0)
+                break;
+        }
+
+        if (ready == 0) {
+            // Cell still belongs to the previous lap: full (producers) or empty (consumers)
+            if (lag < 0)
+                return 0;
+
+            // Another thread claimed this position first
+            position = counter.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (counter.compare_exchange_weak(position, position + ready, std::memory_order_relaxed))
+            return ready;
+    }
+}
+
+
+/**
+ * Spins briefly, then yields the core, while waiting on other threads.
+ */
+template <typename T>
+inline void MPMCQueue<T>::_backOff(int & spins) {
+    if (++spins > SPINS_BEFORE_YIELD)
+        std::this_thread::yield();
+}
+
+
+#endif //MPMC_QUEUE_H
@@ -0,0 +1,177 @@
+//   File: NodePool.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Slab allocator for fixed-size tree nodes.
+//         Nodes are carved from contiguous slabs owned by the pool and recycled
+//         through a free list, so a tree never touches the global heap per node.
+// ---------------------------------------------------------------------
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+template <typename Node>
+class NodePool {
+private:
+    // A slot either holds a live node or links to the next free slot
+    union Slot {
+        Slot* nextFree;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    struct Slab {
+        Slot* slots;
+        Slab* nextSlab;
+    };
+
+    static const int FIRST_SLAB_SIZE = 64;
+    static const int MAX_SLAB_SIZE = 65536;
+
+    Slab* slabList;     // Most recently allocated slab first
+    Slot* freeList;     // Slots returned by destroy()
+    Slot* nextSlot;     // Bump pointer into the newest slab
+    Slot* slabEnd;
+    int nextSlabSize;
+    std::size_t reservedBytes;  // Total size of every slab
+
+public:
+    // Constructors
+    NodePool();
+    ~NodePool();
+    NodePool(const NodePool &) = delete;
+    NodePool & operator =(const NodePool &) = delete;
+
+    // Pool Management Methods
+    template <typename... Args>
+    Node* create(Args &&... args);
+    void destroy(Node* node);
+    void releaseAll();
+    std::size_t bytesReserved() const { return reservedBytes; }
+
+private:
+    Slot* _allocateSlot();
+    void _addSlab();
+};
+
+
+// ---------------------------------------------------------------------
+//                          Constructors
+
+/**
+ * Default constructor. No memory is reserved until the first node is created.
+ */
+template <typename Node>
+NodePool<Node>::NodePool() {
+    slabList = nullptr;
+    freeList = nullptr;
+    nextSlot = nullptr;
+    slabEnd = nullptr;
+    nextSlabSize = FIRST_SLAB_SIZE;
+    reservedBytes = 0;
+}
+
+
+/**
+ * Destructor. Releases every slab; live nodes must already have been destroyed
+ * in place if they own resources.
+ */
+template <typename Node>
+NodePool<Node>::~NodePool() {
+    releaseAll();
+}
+
+
+// ---------------------------------------------------------------------
+//                     Public Pool Management Methods
+
+/**
+ * Constructs a node in pooled memory.
+ * @param args - Arguments forwarded to the node's constructor.
+ * @return Returns a pointer to the new node.
+ */
+template <typename Node>
+template <typename... Args>
+Node* NodePool<Node>::create(Args &&... args) {
+    Slot* slot = _allocateSlot();
+    return new (slot->storage) Node(std::forward<Args>(args)...);
+}
+
+
+/**
+ * Runs a node's destructor and returns its slot to the free list for reuse.
+ * @param node - Node previously returned by create().
+ */
+template <typename Node>
+void NodePool<Node>::destroy(Node* node) {
+    node->~Node();
+
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->nextFree = freeList;
+    freeList = slot;
+}
+
+
+/**
+ * Frees every slab at once. Does not run node destructors.
+ */
+template <typename Node>
+void NodePool<Node>::releaseAll() {
+    while (slabList) {
+        Slab* tempSlab = slabList;
+        slabList = slabList->nextSlab;
+
+        delete[] tempSlab->slots;
+        delete tempSlab;
+    }
+
+    freeList = nullptr;
+    nextSlot = nullptr;
+    slabEnd = nullptr;
+    nextSlabSize = FIRST_SLAB_SIZE;
+    reservedBytes = 0;
+}
+
+
+// ---------------------------------------------------------------------
+//                     Private Pool Management Methods
+
+/**
+ * Takes a slot from the free list, or from the newest slab if the free list is empty.
+ * @return Returns uninitialized storage for one node.
+ */
+template <typename Node>
+typename NodePool<Node>::Slot* NodePool<Node>::_allocateSlot() {
+    if (freeList) {
+        Slot* slot = freeList;
+        freeList = freeList->nextFree;
+        return slot;
+    }
+
+    if (nextSlot == slabEnd)
+        _addSlab();
+
+    return nextSlot++;
+}
+
+
+/**
+ * Allocates a new slab. Slab sizes double up to MAX_SLAB_SIZE so small trees stay small.
+ */
+template <typename Node>
+void NodePool<Node>::_addSlab() {
+    auto* newSlab = new Slab{new Slot[nextSlabSize], slabList};
+    slabList = newSlab;
+
+    nextSlot = newSlab->slots;
+    slabEnd = newSlab->slots + nextSlabSize;
+    reservedBytes += sizeof(Slot) * std::size_t(nextSlabSize);
+
+    if (nextSlabSize < MAX_SLAB_SIZE)
+        nextSlabSize *= 2;
+}
+
+
+#endif //NODEPOOL_H
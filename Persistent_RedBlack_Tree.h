@@ -0,0 +1,945 @@
+//   File: Persistent_RedBlack_Tree.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Persistent (path-copying) Red-Black Tree declarations and definitions.
+//         Every insert or remove copies only the nodes on its search path and
+//         publishes a new root; untouched subtrees are shared with every older
+//         version. Readers never lock: they either take an O(1) snapshot that
+//         pins a version, or pin the current epoch for a single lookup.
+//         Nodes are reference counted, and a retired root's reference is only
+//         dropped once no reader can still be walking it (epoch-based reclamation).
+//         Balancing follows the left-leaning red-black rules, which need no
+//         parent pointers and so allow sharing subtrees between versions.
+//         Keys are ordered by Compare (KeyCompare by default), so the tree can
+//         be CursedArray storage; CursedArray::snapshot() then gives readers a
+//         consistent view of the array in O(1).
+// ---------------------------------------------------------------------
+
+#ifndef PERSISTENT_REDBLACKTREE_H
+#define PERSISTENT_REDBLACKTREE_H
+
+#include "Key_Traits.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+template <typename K, typename V, typename Compare = KeyCompare<K>>
+class PersistentRedBlackTree {
+public:
+    enum { BLACK, RED };
+
+private:
+    struct PersistentNode {
+        K key;
+        V value;
+        bool color;
+        int subtreeSize;
+        uint64_t version;               // Write that created the node; only that write may modify it
+        std::atomic<int> references;    // Parent nodes, snapshots, and published roots pointing here
+        PersistentNode* leftChild;
+        PersistentNode* rightChild;
+
+        template <typename... Args>
+        PersistentNode(const K & key, bool c, uint64_t ver, Args &&... args)
+                : key{key}, value(std::forward<Args>(args)...), color{c}, subtreeSize{1}, version{ver},
+                  references{1}, leftChild{nullptr}, rightChild{nullptr} {}
+    };  // End PersistentNode
+
+    static const int READER_SLOTS = 64;
+
+    // Readers announce themselves in the counter for the epoch they entered.
+    // Padded so readers on different slots never share a cache line.
+    struct alignas(64) ReaderSlot {
+        std::atomic<int> readers[2] = {{0}, {0}};
+    };
+
+    struct RetiredRoot {
+        PersistentNode* root;
+        uint64_t epoch;                 // Epoch in which the root was replaced
+    };
+
+    std::atomic<PersistentNode*> _root;         // Current version, holds one reference
+    std::atomic<uint64_t> _epoch;
+    ReaderSlot _readerSlots[READER_SLOTS];
+
+    std::mutex _writerMutex;                    // Serializes writers; readers never touch it
+    uint64_t _writeVersion;
+    std::vector<RetiredRoot> _retiredRoots;
+
+public:
+    // Immutable view of one version of the tree. Holds a reference on its root, so
+    // it stays readable for as long as it lives, no matter what writers do.
+    class Snapshot {
+        friend class PersistentRedBlackTree;
+        PersistentNode* _root;
+
+        explicit Snapshot(PersistentNode* root) : _root{root} {}
+    public:
+        Snapshot() : _root{nullptr} {}
+        Snapshot(const Snapshot & other) : _root{other._root} { _retain(_root); }
+        Snapshot(Snapshot && other) noexcept : _root{other._root} { other._root = nullptr; }
+        Snapshot & operator =(Snapshot other) { std::swap(_root, other._root); return *this; }
+        ~Snapshot() { _release(_root); }
+
+        const V* findValue(const K & key) const { return _findValue(_root, key); }
+        int size() const { return _size(_root); }
+
+        template <typename Visitor>
+        void visitInOrder(Visitor visit) const { _visitInOrder(_root, visit); }
+        template <typename Visitor>
+        void visitRange(const K & low, const K & high, Visitor visit) const;
+    };
+
+    // Bidirectional iterator over the current version, for the writer. Holds the path
+    // from the root, so any write invalidates it. Values are read-only.
+    class iterator {
+        friend class PersistentRedBlackTree;
+        const PersistentRedBlackTree* _tree;
+        std::vector<const PersistentNode*> _path;     // Empty for end()
+
+        explicit iterator(const PersistentRedBlackTree* tree) : _tree{tree} {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = V;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const V*;
+        using reference = const V&;
+
+        iterator() : _tree{nullptr} {}
+
+        const K & key() const { return _path.back()->key; }
+        const V & value() const { return _path.back()->value; }
+        const V & operator*() const { return value(); }
+        const V * operator->() const { return &value(); }
+
+        iterator & operator++();
+        iterator & operator--();
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        iterator operator--(int) { iterator old = *this; --*this; return old; }
+
+        bool operator==(const iterator & other) const {
+            return _path.empty() ? other._path.empty() : (!other._path.empty() and _path.back() == other._path.back());
+        }
+        bool operator!=(const iterator & other) const { return !(*this == other); }
+    };
+
+    // Constructors
+    PersistentRedBlackTree();
+    ~PersistentRedBlackTree();
+    PersistentRedBlackTree(const PersistentRedBlackTree &) = delete;
+    PersistentRedBlackTree & operator =(const PersistentRedBlackTree &) = delete;
+
+    // Tree Management Methods
+    void insert(const K & key, const V & value);
+    template <typename M>
+    std::pair<V*, bool> insert_or_assign(const K & key, M && value);
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K & key, Args &&... args);
+    bool remove(const K & key);
+    bool findValue(const K & key, V & valueOut);
+    V* findValue(const K & key);
+    int size();
+    void clear();
+
+    template <typename KeyIt, typename ValueIt>
+    void assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue);
+    template <typename Visitor>
+    void visitInOrder(Visitor visit) { _visitInOrder(_root.load(std::memory_order_relaxed), visit); }
+
+    // Iterator Methods (writer only)
+    iterator begin();
+    iterator end() const { return iterator(this); }
+    iterator lower_bound(const K & key) const { return _ceil(key, false); }
+    iterator upper_bound(const K & key) const { return _ceil(key, true); }
+    iterator floor(const K & key) const;
+    iterator ceil(const K & key) const { return _ceil(key, false); }
+
+    // Version Methods
+    Snapshot snapshot();
+
+private:
+    // Reader Epochs
+    uint64_t _pin();
+    void _unpin(uint64_t epoch);
+    static int _mySlot();
+    void _publish(PersistentNode* newRoot);
+    void _reclaim();
+
+    // Reference Counting
+    static void _retain(PersistentNode* node);
+    static void _release(PersistentNode* node);
+
+    // Read-only Helpers
+    static bool _less(const K & a, const K & b) { return Compare::compare(a, b) < 0; }
+    static const V* _findValue(const PersistentNode* root, const K & key);
+    static int _size(const PersistentNode* node);
+    static bool _isRed(const PersistentNode* node);
+    template <typename Visitor>
+    static void _visitInOrder(const PersistentNode* root, Visitor & visit);
+    iterator _ceil(const K & key, bool strict) const;
+
+    // Path Copying
+    template <typename... Args>
+    std::pair<V*, bool> _write(const K & key, Args &&... args);
+    PersistentNode* _own(PersistentNode* node);
+    template <typename... Args>
+    PersistentNode* _insert(PersistentNode* node, const K & key, V* & placed, Args &&... args);
+    PersistentNode* _remove(PersistentNode* node, const K & key);
+    PersistentNode* _removeMin(PersistentNode* node);
+
+    // Re-balancing
+    PersistentNode* _rotateLeft(PersistentNode* node);
+    PersistentNode* _rotateRight(PersistentNode* node);
+    void _flipColors(PersistentNode* node);
+    PersistentNode* _moveRedLeft(PersistentNode* node);
+    PersistentNode* _moveRedRight(PersistentNode* node);
+    PersistentNode* _fixUp(PersistentNode* node);
+};
+
+
+// ---------------------------------------------------------------------
+//                          Constructors
+
+/**
+ * Default constructor
+ */
+template <typename K, typename V, typename Compare>
+PersistentRedBlackTree<K,V,Compare>::PersistentRedBlackTree() : _root{nullptr}, _epoch{2}, _writeVersion{0} {}
+
+
+/**
+ * Destructor. Snapshots taken from the tree stay valid; no reader may be mid-lookup.
+ */
+template <typename K, typename V, typename Compare>
+PersistentRedBlackTree<K,V,Compare>::~PersistentRedBlackTree() {
+    for (RetiredRoot & retired : _retiredRoots)
+        _release(retired.root);
+    _release(_root.load());
+}
+
+
+// ---------------------------------------------------------------------
+//                  Public Tree Management Methods
+
+/**
+ * Inserts a key-value pair, overwriting the value if the key is already saved.
+ * Copies the search path and publishes the result as a new version.
+ * @param key - Key to save.
+ * @param value - Value to save.
+ */
+template <typename K, typename V, typename Compare>
+void PersistentRedBlackTree<K,V,Compare>::insert(const K & key, const V & value) {
+    _write(key, value);
+}
+
+
+/**
+ * Same as insert(), moving an rvalue into the new version.
+ * @return Returns the value in the new version and whether the key was newly saved.
+ *         Snapshots taken later share the value, so it must not be changed through the pointer.
+ */
+template <typename K, typename V, typename Compare>
+template <typename M>
+std::pair<V*, bool> PersistentRedBlackTree<K,V,Compare>::insert_or_assign(const K & key, M && value) {
+    return _write(key, std::forward<M>(value));
+}
+
+
+/**
+ * Constructs a value at an unsaved key, publishing a new version. A saved key is left
+ * as it is, and no version is published.
+ * @param args - Arguments for V's constructor.
+ * @return Returns the value at the key and whether it was inserted. The value may be
+ *         shared with snapshots, so it must not be changed through the pointer.
+ */
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<V*, bool> PersistentRedBlackTree<K,V,Compare>::try_emplace(const K & key, Args &&... args) {
+    if (V* value = findValue(key))
+        return {value, false};
+
+    return _write(key, std::forward<Args>(args)...);
+}
+
+
+/**
+ * Removes a key, publishing the result as a new version.
+ * @param key - Key to remove.
+ * @return Returns true if the key was saved.
+ */
+template <typename K, typename V, typename Compare>
+bool PersistentRedBlackTree<K,V,Compare>::remove(const K & key) {
+    std::lock_guard<std::mutex> guard(_writerMutex);
+
+    PersistentNode* workingRoot = _root.load(std::memory_order_relaxed);
+    if (!_findValue(workingRoot, key))
+        return false;
+
+    ++_writeVersion;
+    _retain(workingRoot);
+    workingRoot = _own(workingRoot);
+    if (!_isRed(workingRoot->leftChild) and !_isRed(workingRoot->rightChild))
+        workingRoot->color = RED;
+
+    workingRoot = _remove(workingRoot, key);
+    if (workingRoot)
+        workingRoot->color = BLACK;
+
+    _publish(workingRoot);
+    return true;
+}
+
+
+/**
+ * Looks a key up in the current version without taking a lock.
+ * @param key - Key to search for.
+ * @param valueOut - Receives a copy of the value if the key is saved.
+ * @return Returns true if the key is saved.
+ */
+template <typename K, typename V, typename Compare>
+bool PersistentRedBlackTree<K,V,Compare>::findValue(const K & key, V & valueOut) {
+    uint64_t epoch = _pin();
+    const V* value = _findValue(_root.load(std::memory_order_acquire), key);
+    if (value)
+        valueOut = *value;
+    _unpin(epoch);
+
+    return value != nullptr;
+}
+
+
+/**
+ * Looks a key up in the current version, for the writer. Readers on other threads
+ * use findValue(key, valueOut) or a snapshot instead.
+ * @return Returns the value, or nullptr if the key is not saved. The value may be
+ *         shared with snapshots, so it must not be changed through the pointer.
+ */
+template <typename K, typename V, typename Compare>
+V* PersistentRedBlackTree<K,V,Compare>::findValue(const K & key) {
+    return const_cast<V*>(_findValue(_root.load(std::memory_order_relaxed), key));
+}
+
+
+/**
+ * @return Returns the number of keys in the current version.
+ */
+template <typename K, typename V, typename Compare>
+int PersistentRedBlackTree<K,V,Compare>::size() {
+    uint64_t epoch = _pin();
+    int currentSize = _size(_root.load(std::memory_order_acquire));
+    _unpin(epoch);
+
+    return currentSize;
+}
+
+
+/**
+ * Publishes an empty version. Snapshots keep the versions they hold.
+ */
+template <typename K, typename V, typename Compare>
+void PersistentRedBlackTree<K,V,Compare>::clear() {
+    std::lock_guard<std::mutex> guard(_writerMutex);
+    ++_writeVersion;
+    _publish(nullptr);
+}
+
+
+/**
+ * Replaces the contents with a sorted range, published as one version.
+ * Every node is new to that version, so the inserts copy nothing; O(n log n).
+ * @param firstKey, lastKey - Keys in strictly ascending order.
+ * @param firstValue - Start of the values matching each key.
+ */
+template <typename K, typename V, typename Compare>
+template <typename KeyIt, typename ValueIt>
+void PersistentRedBlackTree<K,V,Compare>::assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue) {
+    std::lock_guard<std::mutex> guard(_writerMutex);
+    ++_writeVersion;
+
+    PersistentNode* workingRoot = nullptr;
+    V* placed;
+    for (; firstKey != lastKey; ++firstKey, ++firstValue) {
+        workingRoot = _insert(workingRoot, *firstKey, placed, *firstValue);
+        workingRoot->color = BLACK;
+    }
+
+    _publish(workingRoot);
+}
+
+
+// ---------------------------------------------------------------------
+//                       Public Iterator Methods
+
+/**
+ * @return Returns an iterator to the smallest key of the current version.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::iterator PersistentRedBlackTree<K,V,Compare>::begin() {
+    iterator it(this);
+    for (const PersistentNode* node = _root.load(std::memory_order_relaxed); node; node = node->leftChild)
+        it._path.push_back(node);
+    return it;
+}
+
+
+/**
+ * @return Returns an iterator to the largest key <= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::iterator PersistentRedBlackTree<K,V,Compare>::floor(const K & key) const {
+    iterator it(this);
+    size_t floorDepth = 0;
+
+    for (const PersistentNode* node = _root.load(std::memory_order_relaxed); node; ) {
+        it._path.push_back(node);
+        if (_less(key, node->key)) {
+            node = node->leftChild;
+        } else {
+            floorDepth = it._path.size();
+            node = node->rightChild;
+        }
+    }
+
+    it._path.resize(floorDepth);    // The path to the floor is a prefix of the search path
+    return it;
+}
+
+
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::iterator & PersistentRedBlackTree<K,V,Compare>::iterator::operator++() {
+    const PersistentNode* node = _path.back();
+
+    if (node->rightChild) {
+        for (node = node->rightChild; node; node = node->leftChild)
+            _path.push_back(node);
+    } else {
+        // Climb until arriving from a left child
+        do {
+            node = _path.back();
+            _path.pop_back();
+        } while (!_path.empty() and _path.back()->rightChild == node);
+    }
+    return *this;
+}
+
+
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::iterator & PersistentRedBlackTree<K,V,Compare>::iterator::operator--() {
+    const PersistentNode* node = _path.empty() ? nullptr : _path.back();
+
+    if (!node or node->leftChild) {
+        // Stepping back from end() lands on the maximum key
+        node = node ? node->leftChild : _tree->_root.load(std::memory_order_relaxed);
+        for (; node; node = node->rightChild)
+            _path.push_back(node);
+    } else {
+        // Climb until arriving from a right child
+        do {
+            node = _path.back();
+            _path.pop_back();
+        } while (!_path.empty() and _path.back()->leftChild == node);
+    }
+    return *this;
+}
+
+
+// ---------------------------------------------------------------------
+//                       Public Version Methods
+
+/**
+ * Takes a consistent view of the current version in O(1), without taking a lock.
+ * @return Returns a snapshot that later writes do not affect.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::Snapshot PersistentRedBlackTree<K,V,Compare>::snapshot() {
+    uint64_t epoch = _pin();
+    PersistentNode* root = _root.load(std::memory_order_acquire);
+    _retain(root);      // Safe: the pinned epoch keeps root's published reference alive
+    _unpin(epoch);
+
+    return Snapshot(root);
+}
+
+
+/**
+ * Visits every (key, value) pair of the snapshot in ascending key order.
+ * @param visit - Called as visit(key, value).
+ */
+template <typename K, typename V, typename Compare>
+template <typename Visitor>
+void PersistentRedBlackTree<K,V,Compare>::_visitInOrder(const PersistentNode* root, Visitor & visit) {
+    std::vector<const PersistentNode*> stack;
+    const PersistentNode* currentNode = root;
+
+    while (currentNode or !stack.empty()) {
+        for (; currentNode; currentNode = currentNode->leftChild)
+            stack.push_back(currentNode);
+
+        currentNode = stack.back();
+        stack.pop_back();
+        visit(currentNode->key, currentNode->value);
+        currentNode = currentNode->rightChild;
+    }
+}
+
+
+/**
+ * Visits every (key, value) pair of the snapshot with key in [low, high], in ascending order.
+ * @param low, high - Inclusive key bounds.
+ * @param visit - Called as visit(key, value).
+ */
+template <typename K, typename V, typename Compare>
+template <typename Visitor>
+void PersistentRedBlackTree<K,V,Compare>::Snapshot::visitRange(const K & low, const K & high, Visitor visit) const {
+    std::vector<const PersistentNode*> stack;
+    const PersistentNode* currentNode = _root;
+
+    while (currentNode or !stack.empty()) {
+        // Skip left subtrees that lie entirely below the range
+        while (currentNode) {
+            if (_less(currentNode->key, low)) {
+                currentNode = currentNode->rightChild;
+            } else {
+                stack.push_back(currentNode);
+                currentNode = currentNode->leftChild;
+            }
+        }
+        if (stack.empty())
+            return;
+
+        currentNode = stack.back();
+        stack.pop_back();
+        if (_less(high, currentNode->key))
+            return;
+
+        visit(currentNode->key, currentNode->value);
+        currentNode = currentNode->rightChild;
+    }
+}
+
+
+// ---------------------------------------------------------------------
+//                          Reader Epochs
+
+/**
+ * Announces a reader in the current epoch. Retired roots from this epoch or later
+ * keep their published reference until the reader unpins.
+ * @return Returns the epoch to pass to _unpin().
+ */
+template <typename K, typename V, typename Compare>
+uint64_t PersistentRedBlackTree<K,V,Compare>::_pin() {
+    ReaderSlot & slot = _readerSlots[_mySlot()];
+
+    while (true) {
+        uint64_t epoch = _epoch.load();
+        slot.readers[epoch & 1].fetch_add(1);   // Sequentially consistent, pairs with _reclaim()
+        if (_epoch.load() == epoch)
+            return epoch;
+
+        // The epoch moved while announcing, retry in the new one
+        slot.readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+    }
+}
+
+
+template <typename K, typename V, typename Compare>
+inline void PersistentRedBlackTree<K,V,Compare>::_unpin(uint64_t epoch) {
+    _readerSlots[_mySlot()].readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+}
+
+
+/**
+ * @return Returns this thread's reader slot, assigned round-robin on first use.
+ */
+template <typename K, typename V, typename Compare>
+inline int PersistentRedBlackTree<K,V,Compare>::_mySlot() {
+    static std::atomic<int> nextSlot{0};
+    static thread_local int slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+    return slot;
+}
+
+
+/**
+ * Makes a finished write visible and retires the version it replaces. Caller holds _writerMutex.
+ * @param newRoot - Root of the new version, carrying one reference.
+ */
+template <typename K, typename V, typename Compare>
+void PersistentRedBlackTree<K,V,Compare>::_publish(PersistentNode* newRoot) {
+    PersistentNode* oldRoot = _root.exchange(newRoot);
+    if (oldRoot)
+        _retiredRoots.push_back({oldRoot, _epoch.load(std::memory_order_relaxed)});
+
+    _reclaim();
+}
+
+
+/**
+ * Readers are only ever pinned in the current epoch or the one before it. Once the
+ * previous epoch has drained, roots retired before the current epoch are unreachable
+ * by readers and the epoch can advance. Caller holds _writerMutex.
+ */
+template <typename K, typename V, typename Compare>
+void PersistentRedBlackTree<K,V,Compare>::_reclaim() {
+    uint64_t epoch = _epoch.load();
+
+    for (ReaderSlot & slot : _readerSlots) {
+        if (slot.readers[(epoch - 1) & 1].load() != 0)
+            return;
+    }
+
+    size_t kept = 0;
+    for (RetiredRoot & retired : _retiredRoots) {
+        if (retired.epoch < epoch)
+            _release(retired.root);
+        else
+            _retiredRoots[kept++] = retired;
+    }
+    _retiredRoots.resize(kept);
+
+    _epoch.store(epoch + 1);
+}
+
+
+// ---------------------------------------------------------------------
+//                        Reference Counting
+
+template <typename K, typename V, typename Compare>
+inline void PersistentRedBlackTree<K,V,Compare>::_retain(PersistentNode* node) {
+    if (node)
+        node->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/**
+ * Drops one reference, freeing the node and releasing its children when it was the last.
+ */
+template <typename K, typename V, typename Compare>
+void PersistentRedBlackTree<K,V,Compare>::_release(PersistentNode* node) {
+    std::vector<PersistentNode*> freed;
+
+    while (node) {
+        if (node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (node->rightChild)
+                freed.push_back(node->rightChild);
+            PersistentNode* leftNode = node->leftChild;
+            delete node;
+            node = leftNode;
+        } else {
+            node = nullptr;
+        }
+
+        if (!node and !freed.empty()) {
+            node = freed.back();
+            freed.pop_back();
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------
+//                         Read-only Helpers
+
+template <typename K, typename V, typename Compare>
+const V* PersistentRedBlackTree<K,V,Compare>::_findValue(const PersistentNode* root, const K & key) {
+    while (root) {
+        int order = Compare::compare(key, root->key);
+        if (order < 0)
+            root = root->leftChild;
+        else if (order > 0)
+            root = root->rightChild;
+        else
+            return &root->value;
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * @param strict - False for the smallest key >= key, true for the smallest key > key.
+ * @return Returns an iterator to that key, or end() if there is none.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::iterator PersistentRedBlackTree<K,V,Compare>::_ceil(const K & key, bool strict) const {
+    iterator it(this);
+    size_t ceilDepth = 0;
+
+    for (const PersistentNode* node = _root.load(std::memory_order_relaxed); node; ) {
+        it._path.push_back(node);
+        if (strict ? _less(key, node->key) : !_less(node->key, key)) {
+            ceilDepth = it._path.size();
+            node = node->leftChild;
+        } else {
+            node = node->rightChild;
+        }
+    }
+
+    it._path.resize(ceilDepth);     // The path to the ceiling is a prefix of the search path
+    return it;
+}
+
+
+template <typename K, typename V, typename Compare>
+inline int PersistentRedBlackTree<K,V,Compare>::_size(const PersistentNode* node) {
+    return node ? node->subtreeSize : 0;
+}
+
+
+template <typename K, typename V, typename Compare>
+inline bool PersistentRedBlackTree<K,V,Compare>::_isRed(const PersistentNode* node) {
+    return node and node->color == RED;
+}
+
+
+// ---------------------------------------------------------------------
+//                           Path Copying
+//
+// Every node pointer held by a parent, snapshot, or local variable owns one
+// reference. The helpers below take a reference and hand one back, so pointers
+// move between slots without touching the counts.
+
+/**
+ * Inserts or overwrites a key as one new version.
+ * @param args - Arguments for V's constructor.
+ * @return Returns the value in the new version and whether the key was newly saved.
+ */
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+std::pair<V*, bool> PersistentRedBlackTree<K,V,Compare>::_write(const K & key, Args &&... args) {
+    std::lock_guard<std::mutex> guard(_writerMutex);
+    ++_writeVersion;
+
+    PersistentNode* workingRoot = _root.load(std::memory_order_relaxed);
+    int oldSize = _size(workingRoot);
+    _retain(workingRoot);   // The published reference stays with the old version
+
+    V* placed;
+    workingRoot = _insert(workingRoot, key, placed, std::forward<Args>(args)...);
+    workingRoot->color = BLACK;
+
+    bool inserted = _size(workingRoot) > oldSize;
+    _publish(workingRoot);
+    return {placed, inserted};
+}
+
+
+/**
+ * Makes a node writable by the current write, copying it if an older version may share it.
+ * @param node - Reference to give up.
+ * @return Returns a reference to a node created by this write.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_own(PersistentNode* node) {
+    if (node->version == _writeVersion)
+        return node;
+
+    PersistentNode* copy = new PersistentNode(node->key, node->color, _writeVersion, node->value);
+    copy->leftChild = node->leftChild;
+    copy->rightChild = node->rightChild;
+    copy->subtreeSize = node->subtreeSize;
+    _retain(copy->leftChild);
+    _retain(copy->rightChild);
+    _release(node);
+
+    return copy;
+}
+
+
+/**
+ * @param placed - Set to the value at key. Later re-balancing only moves nodes this
+ *                 write created, so the pointer stays valid.
+ * @param args - Arguments for V's constructor.
+ */
+template <typename K, typename V, typename Compare>
+template <typename... Args>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_insert(PersistentNode* node, const K & key, V* & placed, Args &&... args) {
+    if (!node) {
+        node = new PersistentNode(key, RED, _writeVersion, std::forward<Args>(args)...);
+        placed = &node->value;
+        return node;
+    }
+
+    node = _own(node);
+    int order = Compare::compare(key, node->key);
+    if (order < 0) {
+        node->leftChild = _insert(node->leftChild, key, placed, std::forward<Args>(args)...);
+    } else if (order > 0) {
+        node->rightChild = _insert(node->rightChild, key, placed, std::forward<Args>(args)...);
+    } else {
+        node->value = V(std::forward<Args>(args)...);
+        placed = &node->value;
+    }
+
+    return _fixUp(node);
+}
+
+
+/**
+ * Removes a key known to be in the subtree.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_remove(PersistentNode* node, const K & key) {
+    node = _own(node);
+
+    if (_less(key, node->key)) {
+        if (!_isRed(node->leftChild) and !_isRed(node->leftChild->leftChild))
+            node = _moveRedLeft(node);
+        node->leftChild = _remove(node->leftChild, key);
+    } else {
+        if (_isRed(node->leftChild))
+            node = _rotateRight(node);
+
+        if (Compare::compare(key, node->key) == 0 and !node->rightChild) {
+            _release(node);     // Left-leaning rules guarantee no left child here either
+            return nullptr;
+        }
+
+        if (!_isRed(node->rightChild) and !_isRed(node->rightChild->leftChild))
+            node = _moveRedRight(node);
+
+        if (Compare::compare(key, node->key) == 0) {
+            // Replace with the in-order successor, then remove the successor
+            const PersistentNode* successor = node->rightChild;
+            while (successor->leftChild)
+                successor = successor->leftChild;
+
+            node->key = successor->key;
+            node->value = successor->value;
+            node->rightChild = _removeMin(node->rightChild);
+        } else {
+            node->rightChild = _remove(node->rightChild, key);
+        }
+    }
+
+    return _fixUp(node);
+}
+
+
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_removeMin(PersistentNode* node) {
+    node = _own(node);
+
+    if (!node->leftChild) {
+        _release(node);
+        return nullptr;
+    }
+
+    if (!_isRed(node->leftChild) and !_isRed(node->leftChild->leftChild))
+        node = _moveRedLeft(node);
+    node->leftChild = _removeMin(node->leftChild);
+
+    return _fixUp(node);
+}
+
+
+// ---------------------------------------------------------------------
+//                          Re-balancing
+//
+// Every function here takes a node already owned by the current write.
+
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_rotateLeft(PersistentNode* node) {
+    PersistentNode* temp = _own(node->rightChild);
+
+    node->rightChild = temp->leftChild;
+    temp->leftChild = node;
+    temp->color = node->color;
+    node->color = RED;
+
+    node->subtreeSize = 1 + _size(node->leftChild) + _size(node->rightChild);
+    temp->subtreeSize = 1 + _size(temp->leftChild) + _size(temp->rightChild);
+    return temp;
+}
+
+
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_rotateRight(PersistentNode* node) {
+    PersistentNode* temp = _own(node->leftChild);
+
+    node->leftChild = temp->rightChild;
+    temp->rightChild = node;
+    temp->color = node->color;
+    node->color = RED;
+
+    node->subtreeSize = 1 + _size(node->leftChild) + _size(node->rightChild);
+    temp->subtreeSize = 1 + _size(temp->leftChild) + _size(temp->rightChild);
+    return temp;
+}
+
+
+template <typename K, typename V, typename Compare>
+void PersistentRedBlackTree<K,V,Compare>::_flipColors(PersistentNode* node) {
+    node->leftChild = _own(node->leftChild);
+    node->rightChild = _own(node->rightChild);
+
+    node->color = !node->color;
+    node->leftChild->color = !node->leftChild->color;
+    node->rightChild->color = !node->rightChild->color;
+}
+
+
+/**
+ * Borrows from the right sibling so the left child is not a lone black node.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_moveRedLeft(PersistentNode* node) {
+    _flipColors(node);
+
+    if (_isRed(node->rightChild->leftChild)) {
+        node->rightChild = _rotateRight(node->rightChild);
+        node = _rotateLeft(node);
+        _flipColors(node);
+    }
+
+    return node;
+}
+
+
+/**
+ * Borrows from the left sibling so the right child is not a lone black node.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_moveRedRight(PersistentNode* node) {
+    _flipColors(node);
+
+    if (_isRed(node->leftChild->leftChild)) {
+        node = _rotateRight(node);
+        _flipColors(node);
+    }
+
+    return node;
+}
+
+
+/**
+ * Restores the left-leaning invariants on the way back up a write path.
+ */
+template <typename K, typename V, typename Compare>
+typename PersistentRedBlackTree<K,V,Compare>::PersistentNode*
+PersistentRedBlackTree<K,V,Compare>::_fixUp(PersistentNode* node) {
+    if (_isRed(node->rightChild) and !_isRed(node->leftChild))
+        node = _rotateLeft(node);
+    if (_isRed(node->leftChild) and _isRed(node->leftChild->leftChild))
+        node = _rotateRight(node);
+    if (_isRed(node->leftChild) and _isRed(node->rightChild))
+        _flipColors(node);
+
+    node->subtreeSize = 1 + _size(node->leftChild) + _size(node->rightChild);
+    return node;
+}
+
+
+#endif //PERSISTENT_REDBLACKTREE_H
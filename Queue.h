@@ -2,28 +2,51 @@
 //  Class: COP 3530, Summer 2023, 51977
 // Author: David West
 //   Desc: Header file for the Queue class.
-//         Contains Node and Queue declarations and definitions (due to templating).
+//         A growable ring buffer: elements live in one contiguous array that
+//         doubles when full, so n enqueues cost O(log n) allocations in total.
+//         Contains Queue declarations and definitions (due to templating).
 // ---------------------------------------------------------------------
 
 #ifndef QUEUE_DATATYPE
 #define QUEUE_DATATYPE
 
-#include "List.h"
+#include <cstddef>
+#include <new>
+#include <utility>
 
 template <typename T>
-class Queue : protected List<T> {
+class Queue {
+
+private:
+    static const int FIRST_CAPACITY = 16;   // Always a power of two, so wrapping is a mask
+
+    // Member Data
+    T* buffer;          // Raw storage; only the _size slots starting at headIndex hold live elements
+    int capacity;
+    int headIndex;
+    int _size;
 
 public:
     // Constructors
     Queue();
     ~Queue();
+    Queue(const Queue &) = delete;
+    Queue & operator =(const Queue &) = delete;
 
     // Member Functions
-    void enqueue( T data );
+    void enqueue( const T & data );
+    void enqueue( T && data );
+    template <typename... Args>
+    T & emplace( Args &&... args );
     T deque();
-    T peek();
+    T & peek();
     int size();
     bool isEmpty();
+    void reserve( int minCapacity );
+
+private:
+    T* _allocate( int newCapacity );
+    void _moveTo( T* newBuffer, int newCapacity );
 };
 
 
@@ -32,13 +55,14 @@ public:
 // -----------------------------------------------------------------------------
 
 /**
- * Default constructor
+ * Default constructor. No memory is allocated until the first enqueue.
  */
 template <typename T>
 Queue<T>::Queue() {
-    List<T>::headNode = nullptr;
-    List<T>::tailNode = nullptr;
-    List<T>::_size = 0;
+    buffer = nullptr;
+    capacity = 0;
+    headIndex = 0;
+    _size = 0;
 }
 
 
@@ -47,57 +71,148 @@ Queue<T>::Queue() {
  */
 template <typename T>
 Queue<T>::~Queue( ) {
-    List<T>::makeEmpty( );
+    while (_size > 0) {
+        buffer[headIndex].~T();
+        headIndex = (headIndex + 1) & (capacity - 1);
+        --_size;
+    }
+
+    ::operator delete(buffer);
+}
+
+
+/**
+ * Adds a copy of the given value to the back of the queue.
+ * @param data - The value to be held by the queue.
+ */
+template <typename T>
+void Queue<T>::enqueue(const T & data) {
+    emplace(data);
 }
 
 
 /**
- * Adds a node with the given value to the back of the queue.
- * @param data (int) - The value to be held by the node.
+ * Moves the given value to the back of the queue.
+ * @param data - The value to be held by the queue.
  */
 template <typename T>
-void Queue<T>::enqueue(T data) {
-    List<T>::insert( data, List<T>::_size );
+void Queue<T>::enqueue(T && data) {
+    emplace(std::move(data));
 }
 
 
 /**
- * Removes the first node from the queue.
- * @return (int) The value of the deleted node.
+ * Constructs a value in place at the back of the queue. The arguments may refer to
+ * elements of the queue itself, e.g. enqueue(peek()), even when it has to grow.
+ * @param args - Arguments forwarded to T's constructor.
+ * @return Returns the new back element.
+ */
+template <typename T>
+template <typename... Args>
+T & Queue<T>::emplace(Args &&... args) {
+    if (_size < capacity) {
+        T* slot = new (buffer + ((headIndex + _size) & (capacity - 1))) T(std::forward<Args>(args)...);
+        ++_size;
+        return *slot;
+    }
+
+    // Full: build the new element before the old buffer, which args may point into, is freed
+    int newCapacity = capacity ? capacity * 2 : FIRST_CAPACITY;
+    T* newBuffer = _allocate(newCapacity);
+    new (newBuffer + _size) T(std::forward<Args>(args)...);
+    _moveTo(newBuffer, newCapacity);
+    return buffer[_size++];
+}
+
+
+/**
+ * Removes the first element from the queue. The queue must not be empty.
+ * @return The removed value.
  */
 template <typename T>
 T Queue<T>::deque() {
-    return List<T>::remove( 0 );
+    T* front = buffer + headIndex;
+    T value = std::move(*front);
+    front->~T();
+
+    headIndex = (headIndex + 1) & (capacity - 1);
+    --_size;
+    return value;
 }
 
 
 /**
- * Returns the value of the first element of the queue.
- * @return (int) - The value of the first node of the queue.
+ * Returns the first element of the queue. The queue must not be empty.
+ * @return The first element of the queue.
  */
 template <typename T>
-T Queue<T>::peek() {
-    return List<T>::headNode->value;
+T & Queue<T>::peek() {
+    return buffer[headIndex];
 }
 
 
 /**
  * Returns the number of elements in the queue.
- * @return (int) - The number of nodes in the queue.
+ * @return (int) - The number of elements in the queue.
  */
 template <typename T>
 inline int Queue<T>::size() {
-    return List<T>::_size;
+    return _size;
 }
 
 
 /**
  * Returns whether the queue has elements.
- * @return (bool) - True if queue has elements.
+ * @return (bool) - True if queue has no elements.
  */
 template <typename T>
 inline bool Queue<T>::isEmpty() {
-    return !(List<T>::headNode);
+    return _size == 0;
+}
+
+
+/**
+ * Makes room for at least minCapacity elements without further allocation.
+ * @param minCapacity - Number of elements the queue should hold.
+ */
+template <typename T>
+void Queue<T>::reserve(int minCapacity) {
+    int newCapacity = capacity ? capacity : FIRST_CAPACITY;
+    while (newCapacity < minCapacity)
+        newCapacity *= 2;
+
+    if (newCapacity > capacity)
+        _moveTo(_allocate(newCapacity), newCapacity);
+}
+
+
+/**
+ * @return Returns raw storage for newCapacity elements.
+ */
+template <typename T>
+inline T* Queue<T>::_allocate(int newCapacity) {
+    return static_cast<T*>(::operator new(sizeof(T) * std::size_t(newCapacity)));
+}
+
+
+/**
+ * Moves the elements into a larger buffer, unwrapping them to start at index 0,
+ * and frees the old one.
+ * @param newBuffer - Storage from _allocate(); slots past the current size are left alone.
+ * @param newCapacity - Power of two larger than the current size.
+ */
+template <typename T>
+void Queue<T>::_moveTo(T* newBuffer, int newCapacity) {
+    for (int i = 0; i < _size; ++i) {
+        T* element = buffer + ((headIndex + i) & (capacity - 1));
+        new (newBuffer + i) T(std::move_if_noexcept(*element));
+        element->~T();
+    }
+
+    ::operator delete(buffer);
+    buffer = newBuffer;
+    capacity = newCapacity;
+    headIndex = 0;
 }
 
 
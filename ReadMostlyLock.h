@@ -0,0 +1,109 @@
+//   File: ReadMostlyLock.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Reader-writer lock for read-heavy data.
+//         Each reader only touches its own cache line, so shared locking scales
+//         with the number of cores. Writers pay for that by waiting on every slot.
+//         Meets the standard SharedMutex requirements (std::shared_lock works).
+// ---------------------------------------------------------------------
+
+#ifndef READMOSTLYLOCK_H
+#define READMOSTLYLOCK_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+class ReadMostlyLock {
+public:
+    static const int READER_SLOTS = 64;
+
+private:
+    // Padded so readers on different slots never share a cache line
+    struct alignas(64) ReaderSlot {
+        std::atomic<int> readers{0};
+    };
+
+    ReaderSlot readerSlots[READER_SLOTS];
+    alignas(64) std::atomic<bool> writerActive{false};
+    std::mutex writerMutex;     // Serializes writers
+
+public:
+    ReadMostlyLock() = default;
+    ReadMostlyLock(const ReadMostlyLock &) = delete;
+    ReadMostlyLock & operator =(const ReadMostlyLock &) = delete;
+
+    // Exclusive (writer) locking
+    void lock();
+    void unlock();
+
+    // Shared (reader) locking
+    void lock_shared();
+    void unlock_shared();
+
+private:
+    static int _mySlot();
+};
+
+
+// ---------------------------------------------------------------------
+//                          Writer Locking
+
+/**
+ * Blocks new readers, then waits for every reader slot to drain.
+ */
+inline void ReadMostlyLock::lock() {
+    writerMutex.lock();
+    writerActive.store(true);   // Sequentially consistent, pairs with the reader's check
+
+    for (ReaderSlot & slot : readerSlots) {
+        while (slot.readers.load() != 0)
+            std::this_thread::yield();
+    }
+}
+
+
+inline void ReadMostlyLock::unlock() {
+    writerActive.store(false, std::memory_order_release);
+    writerMutex.unlock();
+}
+
+
+// ---------------------------------------------------------------------
+//                          Reader Locking
+
+/**
+ * Announces a reader on this thread's slot, then backs off if a writer got in first.
+ */
+inline void ReadMostlyLock::lock_shared() {
+    std::atomic<int> & readers = readerSlots[_mySlot()].readers;
+
+    while (true) {
+        readers.fetch_add(1);       // Sequentially consistent, pairs with the writer's flag
+        if (!writerActive.load())
+            return;
+
+        // A writer holds or is taking the lock, step aside until it finishes
+        readers.fetch_sub(1, std::memory_order_release);
+        while (writerActive.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+}
+
+
+inline void ReadMostlyLock::unlock_shared() {
+    readerSlots[_mySlot()].readers.fetch_sub(1, std::memory_order_release);
+}
+
+
+/**
+ * @return Returns this thread's reader slot, assigned round-robin on first use.
+ */
+inline int ReadMostlyLock::_mySlot() {
+    static std::atomic<int> nextSlot{0};
+    static thread_local int slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+    return slot;
+}
+
+
+#endif //READMOSTLYLOCK_H
@@ -0,0 +1,193 @@
+//   File: RedBlack_Augments.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Node augmentation policies for RedBlackTree.
+//         A policy adds per-node data summarizing the node's subtree and says how
+//         to recompute it from the node and its children. The tree calls update()
+//         bottom-up whenever a subtree changes shape.
+//         A policy with HAS_LAZY_TAGS instead holds pending updates for a node's
+//         children, which the tree pushes down before it reads below or rotates
+//         the node.
+// ---------------------------------------------------------------------
+
+#ifndef REDBLACK_AUGMENTS_H
+#define REDBLACK_AUGMENTS_H
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+/**
+ * Default policy: nodes carry no extra data and the tree skips all upkeep.
+ */
+struct NoAugment {
+    static constexpr bool TRACKS_SIZE = false;
+    static constexpr bool TRACKS_AGGREGATE = false;
+    static constexpr bool HAS_LAZY_TAGS = false;
+
+    struct NodeData {};
+
+    template <typename Node>
+    static void update(Node*) {}
+};
+
+
+/**
+ * Stores the number of nodes in each subtree, enabling rank() and select() in O(log n).
+ */
+struct OrderStatistics {
+    static constexpr bool TRACKS_SIZE = true;
+    static constexpr bool TRACKS_AGGREGATE = false;
+    static constexpr bool HAS_LAZY_TAGS = false;
+
+    struct NodeData {
+        int subtreeSize = 1;
+    };
+
+    template <typename Node>
+    static int size(const Node* node) {
+        return node ? node->augment.subtreeSize : 0;
+    }
+
+    template <typename Node>
+    static void update(Node* node) {
+        node->augment.subtreeSize = 1 + size(node->leftChild) + size(node->rightChild);
+    }
+};
+
+
+/**
+ * Caches a monoid summary of the values in each subtree, enabling aggregate(lo, hi) in O(log n).
+ * Summaries depend on values, so values must be changed through insert() rather than
+ * through a reference from cursedInsert() or an iterator.
+ * @tparam M - Monoid with value_type, identity(), combine(a, b), and fromValue(v).
+ *             combine must be associative; it is applied in key order.
+ */
+template <typename M>
+struct RangeAggregate {
+    static constexpr bool TRACKS_SIZE = false;
+    static constexpr bool TRACKS_AGGREGATE = true;
+    static constexpr bool HAS_LAZY_TAGS = false;
+
+    using Monoid = M;
+    using value_type = typename M::value_type;
+
+    struct NodeData {
+        value_type summary = M::identity();
+    };
+
+    template <typename Node>
+    static value_type summary(const Node* node) {
+        return node ? node->augment.summary : M::identity();
+    }
+
+    template <typename Node>
+    static void update(Node* node) {
+        node->augment.summary = M::combine(M::combine(summary(node->leftChild), M::fromValue(node->value)),
+                                           summary(node->rightChild));
+    }
+};
+
+
+/**
+ * Lazy value-add tags, enabling addToAll() in O(1) and addToRange(lo, hi) in O(log n).
+ * A node's value is already up to date; its tag is a delta its descendants still owe,
+ * so a value is only current once every ancestor above it has been pushed down.
+ * The tree does that on every descent, but a reference or iterator taken before a
+ * bulk add still shows the old value.
+ * @tparam V - Value type; needs V() as zero and +=.
+ */
+template <typename V>
+struct LazyAdd {
+    static constexpr bool TRACKS_SIZE = false;
+    static constexpr bool TRACKS_AGGREGATE = false;
+    static constexpr bool HAS_LAZY_TAGS = true;
+
+    struct NodeData {
+        V pending = V();
+        bool hasPending = false;
+    };
+
+    template <typename Node>
+    static void update(Node*) {}
+
+    // Adds delta to a node now and to its whole subtree later
+    template <typename Node>
+    static void apply(Node* node, const V & delta) {
+        if (!node)
+            return;
+
+        node->value += delta;
+        node->augment.pending += delta;
+        node->augment.hasPending = true;
+    }
+
+    // Hands a node's tag to its children, making their values current
+    template <typename Node>
+    static void push(Node* node) {
+        if (!node->augment.hasPending)
+            return;
+
+        apply(node->leftChild, node->augment.pending);
+        apply(node->rightChild, node->augment.pending);
+        node->augment.pending = V();
+        node->augment.hasPending = false;
+    }
+};
+
+
+/**
+ * True for a tree whose augmentation has lazy tags. Reads push tags down, so such a
+ * tree must not be read concurrently.
+ */
+template <typename Tree, typename = void>
+struct HasLazyTags : std::false_type {};
+
+template <typename Tree>
+struct HasLazyTags<Tree, std::void_t<typename Tree::augment_type>>
+        : std::integral_constant<bool, Tree::augment_type::HAS_LAZY_TAGS> {};
+
+
+// ---------------------------------------------------------------------
+//                        Monoids for RangeAggregate
+
+template <typename T>
+struct SumMonoid {
+    using value_type = T;
+    static T identity() { return T(); }
+    static T combine(const T & a, const T & b) { return a + b; }
+    template <typename V>
+    static T fromValue(const V & value) { return T(value); }
+};
+
+
+template <typename T>
+struct MinMonoid {
+    using value_type = T;
+    static T identity() { return std::numeric_limits<T>::max(); }
+    static T combine(const T & a, const T & b) { return std::min(a, b); }
+    template <typename V>
+    static T fromValue(const V & value) { return T(value); }
+};
+
+
+template <typename T>
+struct MaxMonoid {
+    using value_type = T;
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+    static T combine(const T & a, const T & b) { return std::max(a, b); }
+    template <typename V>
+    static T fromValue(const V & value) { return T(value); }
+};
+
+
+struct CountMonoid {
+    using value_type = int;
+    static int identity() { return 0; }
+    static int combine(int a, int b) { return a + b; }
+    template <typename V>
+    static int fromValue(const V &) { return 1; }
+};
+
+
+#endif //REDBLACK_AUGMENTS_H
@@ -8,19 +8,34 @@
 #define REDBLACKTREE_H
 
 #include "Queue.h" // Used in breadth-first findValue
+#include "NodePool.h"
+#include "Key_Traits.h"
+#include "RedBlack_Augments.h"
+#include "Value_Index.h"
+#include "Cursed_Stats.h"
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <iostream>
 using std::cout;
 
-template <typename K, typename V>
+template <typename K, typename V, typename Augment = NoAugment, typename Compare = KeyCompare<K>,
+          typename Index = NoValueIndex>
 class RedBlackTree {
+    static_assert(!(Augment::HAS_LAZY_TAGS and Index::ENABLED), "Lazy tags change values the value index cannot see");
 public:
     enum { BLACK, RED };
+    using augment_type = Augment;
 private:
     struct RedBlackNode {
         K key;
         V value;
         bool color;
+        typename Augment::NodeData augment;     // Subtree summary kept by the Augment policy
         RedBlackNode* parent;
         RedBlackNode* leftChild;
         RedBlackNode* rightChild;
@@ -33,6 +48,11 @@ private:
         RedBlackNode(const K & key, V && val, bool c = RED,
                               RedBlackNode* p = nullptr, RedBlackNode* l = nullptr, RedBlackNode* r = nullptr)
                 : key{key}, value{std::move(val)}, parent{p},leftChild{l}, rightChild{r}, color{c} {}
+        // Value is constructed in place from the remaining arguments
+        template <typename... Args>
+        RedBlackNode(std::piecewise_construct_t, const K & key, Args &&... args)
+                : key{key}, value(std::forward<Args>(args)...), color{RED},
+                  parent{nullptr}, leftChild{nullptr}, rightChild{nullptr} {}
         // Value is to be assigned after construction
         explicit RedBlackNode(const K & key, bool c = RED,
                               RedBlackNode* p = nullptr, RedBlackNode* l = nullptr, RedBlackNode* r = nullptr)
@@ -42,31 +62,141 @@ private:
 
     RedBlackNode* treeRoot;
     int _size;
+    NodePool<RedBlackNode> _nodePool;   // Owns the memory of every node in the tree
+    Index _valueIndex;                  // Value -> key lookups for findKey() (HashValueIndex only)
+#ifdef CURSED_ARRAY_STATS
+    TreeStats _stats;
+#endif
 
 public:
+    // Bidirectional in-order iterator. Dereferences to the value; key() gives the key.
+    // Stays valid until the node it points at is removed.
+    class iterator {
+        friend class RedBlackTree;
+        RedBlackTree* _tree;
+        RedBlackNode* _node;     // nullptr for end()
+
+        iterator(RedBlackTree* tree, RedBlackNode* node) : _tree{tree}, _node{node} {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = V;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        iterator() : _tree{nullptr}, _node{nullptr} {}
+
+        const K & key() const { return _node->key; }
+        V & value() const { return _node->value; }
+        V & operator*() const { return _node->value; }
+        V * operator->() const { return &_node->value; }
+
+        iterator & operator++() {
+            _node = _successor(_node);
+            return *this;
+        }
+        iterator & operator--() {
+            // Stepping back from end() lands on the maximum key
+            _node = _node ? _predecessor(_node) : (_tree->treeRoot ? _findMaxNode(_tree->treeRoot) : nullptr);
+            return *this;
+        }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        iterator operator--(int) { iterator old = *this; --*this; return old; }
+
+        bool operator==(const iterator & other) const { return _node == other._node; }
+        bool operator!=(const iterator & other) const { return _node != other._node; }
+    };
+
     // Constructors
     RedBlackTree();
     ~RedBlackTree();
 
     // Tree Management Methods
     void insert(const K & key, const V & value);
+    void insert(const K & key, V && value);
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K & key, Args &&... args);
+    template <typename... Args>
+    std::pair<V*, bool> emplace(const K & key, Args &&... args);
+    template <typename M>
+    std::pair<V*, bool> insert_or_assign(const K & key, M && value);
     V& cursedInsert(const K & key); // Used in [] operator overloading
     bool remove(const K & key);
-    V& findValue(const K & key);
-    K findKey(const V & value);
+    V* findValue(const K & key);
+    const K* findKey(const V & value);
+    std::vector<K> findKeys(const V & value);
+    std::size_t valueIndexBytes() const;
     int size();
+    void clear();
+
+    // Bulk Construction Methods
+    template <typename KeyIt, typename ValueIt>
+    void assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue);
+    template <typename KeyIt, typename ValueIt>
+    void assign(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue);
 
     // Traversal Methods
     void preOrderTraverse();
     void inOrderTraverse();
     void postOrderTraverse();
     void breadthFirstTraverse();
+    template <typename Visitor>
+    void visitInOrder(Visitor visit);
+    template <typename Visitor>
+    void visitBreadthFirst(Visitor visit);
+
+    // Iterator Methods
+    iterator begin();
+    iterator end();
+    iterator lower_bound(const K & key);
+    iterator upper_bound(const K & key);
+
+    // Range Query Methods
+    iterator floor(const K & key);
+    iterator ceil(const K & key);
+
+    // Order Statistic Methods (OrderStatistics augmentation only)
+    int rank(const K & key);
+    iterator select(int position);
+
+    // Range Aggregate Methods (RangeAggregate augmentation only)
+    template <typename A = Augment>
+    typename A::value_type aggregate(const K & low, const K & high);
+
+    // Lazy Update Methods (LazyAdd augmentation only)
+    void addToAll(const V & delta);
+    void addToRange(const K & low, const K & high, const V & delta);
+
+#ifdef CURSED_ARRAY_STATS
+    // Stats Methods (CURSED_ARRAY_STATS builds only)
+    struct ShapeStats {
+        int height;
+        int blackHeight;
+        int nodeCount;
+        std::size_t bytesUsed;
+    };
+
+    const TreeStats & stats() const { return _stats; }
+    ShapeStats shape();
+    void reportStats(std::ostream & out);
+#endif
 
 private:
     // Tree Management Methods
-    V* _insert(RedBlackNode* & parent, RedBlackNode* & newNode);
-    bool _remove(const K & key, RedBlackNode* node);
-    K _findMinValue(RedBlackNode* root);
+    RedBlackNode* _findNode(const K & key);
+    RedBlackNode* _findSlot(const K & key, RedBlackNode* & parentNode);
+    void _bracket(const K & key, RedBlackNode* & floorNode, RedBlackNode* & ceilNode);
+    void _attachNode(RedBlackNode* newNode, RedBlackNode* parentNode);
+    void _removeNode(RedBlackNode* node);
+    void _transplant(RedBlackNode* oldNode, RedBlackNode* newNode);
+    static bool _less(const K & a, const K & b) { return Compare::compare(a, b) < 0; }
+    static void _pushDown(RedBlackNode* node);
+    static RedBlackNode* _findMinNode(RedBlackNode* root);
+    static RedBlackNode* _findMaxNode(RedBlackNode* root);
+    static RedBlackNode* _successor(RedBlackNode* node);
+    static RedBlackNode* _predecessor(RedBlackNode* node);
+    template <typename KeyIt, typename ValueIt>
+    RedBlackNode* _buildBalanced(KeyIt & nextKey, ValueIt & nextValue, int count, int depth, int redDepth);
 
     // Traversal Methods
     void _preOrderTraverse(RedBlackNode* & root, void(*operation)(RedBlackNode*));
@@ -79,15 +209,23 @@ private:
     static void _printValue(RedBlackNode* node);
     static void _calcHeight(RedBlackNode* node);
 
+    // Augmentation Upkeep
+    void _updatePath(RedBlackNode* node);
+
+    // Value Index Upkeep
+    void _indexAdd(RedBlackNode* node);
+    void _indexErase(RedBlackNode* node);
+    void _refreshValueIndex();
+
     // Re-balancing
     void _leftRotate(RedBlackNode* node);
     void _rightRotate(RedBlackNode* node);
     void _leftRightRotate(RedBlackNode* node);
     void _rightLeftRotate(RedBlackNode* node);
 
-    void _rotate(RedBlackNode* node);
-    void _correctTree(RedBlackNode* node);
+    void _recolor(RedBlackNode* node, bool color);
     void _checkColor(RedBlackNode* node);
+    void _checkRemovedColor(RedBlackNode* node, RedBlackNode* parentNode);
 };
 
 
@@ -97,8 +235,8 @@ private:
 /**
  * Default constructor
  */
-template <typename K, typename V>
-RedBlackTree<K,V>::RedBlackTree() {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+RedBlackTree<K,V,Augment,Compare,Index>::RedBlackTree() {
     treeRoot = nullptr;
     _size = 0;
 }
@@ -107,9 +245,9 @@ RedBlackTree<K,V>::RedBlackTree() {
 /**
  * Destructor
  */
-template <typename K, typename V>
-RedBlackTree<K,V>::~RedBlackTree() {
-    _postOrderTraverse(treeRoot, & RedBlackTree::_deleteNode);
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+RedBlackTree<K,V,Augment,Compare,Index>::~RedBlackTree() {
+    clear();
 }
 
 
@@ -117,24 +255,84 @@ RedBlackTree<K,V>::~RedBlackTree() {
 //                  Public Tree Management Methods
 
 /**
- * Adds a (key, value) pair to the tree.
- * @param data (int) - Value to be added.
+ * Adds a (key, value) pair to the tree, overwriting the value if the key exists.
+ * @param key - Key to determine placement in tree.
+ * @param value - Value to store at the key.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::insert(const K & key, const V & value) {
-    auto* newNode = new RedBlackNode(key, value);
-    if (!treeRoot) {
-        // First node to be inserted into the tree
-        treeRoot = newNode;
-        treeRoot->color = BLACK;
-        ++_size;
-        return;
-    }
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::insert(const K & key, const V & value) {
+    insert_or_assign(key, value);
+} // End insert()
 
-    // A tree root exists
-    _insert(treeRoot, newNode);
 
-} // End insert()
+/**
+ * Adds a (key, value) pair to the tree, moving the value into place.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::insert(const K & key, V && value) {
+    insert_or_assign(key, std::move(value));
+}
+
+
+/**
+ * Constructs a value in a new node from the given arguments, unless the key exists.
+ * @param key - Key to determine placement in tree.
+ * @param args - Arguments for V's constructor. Left untouched if the key exists.
+ * @return Returns the value at the key and whether it was inserted.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename... Args>
+std::pair<V*, bool> RedBlackTree<K,V,Augment,Compare,Index>::try_emplace(const K & key, Args &&... args) {
+    RedBlackNode* parentNode;
+    RedBlackNode* existingNode = _findSlot(key, parentNode);
+
+    if (existingNode)
+        return {&existingNode->value, false};
+
+    RedBlackNode* newNode = _nodePool.create(std::piecewise_construct, key, std::forward<Args>(args)...);
+    _attachNode(newNode, parentNode);
+    _indexAdd(newNode);
+    return {&newNode->value, true};
+}
+
+
+/**
+ * Same as try_emplace(). The key is passed separately, so no value is built for an existing key.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename... Args>
+std::pair<V*, bool> RedBlackTree<K,V,Augment,Compare,Index>::emplace(const K & key, Args &&... args) {
+    return try_emplace(key, std::forward<Args>(args)...);
+}
+
+
+/**
+ * Assigns a value to a key, forwarding it into the existing node or constructing
+ * a new node from it, so an rvalue is moved exactly once.
+ * @param key - Key to determine placement in tree.
+ * @param value - Value to store at the key.
+ * @return Returns the value at the key and whether the key was inserted.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename M>
+std::pair<V*, bool> RedBlackTree<K,V,Augment,Compare,Index>::insert_or_assign(const K & key, M && value) {
+    RedBlackNode* parentNode;
+    RedBlackNode* existingNode = _findSlot(key, parentNode);
+
+    if (existingNode) {
+        _indexErase(existingNode);
+        existingNode->value = std::forward<M>(value);
+        _indexAdd(existingNode);
+        if (Augment::TRACKS_AGGREGATE)
+            _updatePath(existingNode);     // Summaries depend on the value
+        return {&existingNode->value, false};
+    }
+
+    RedBlackNode* newNode = _nodePool.create(std::piecewise_construct, key, std::forward<M>(value));
+    _attachNode(newNode, parentNode);
+    _indexAdd(newNode);
+    return {&newNode->value, true};
+}
 
 
 /**
@@ -145,243 +343,778 @@ void RedBlackTree<K,V>::insert(const K & key, const V & value) {
  * @param key Key/Index to determine placement in tree. Must be comparable.
  * @return Returns a reference to the node's value for either the node with either the matched key or a new key.
  */
-template <typename K, typename V>
-V& RedBlackTree<K,V>::cursedInsert(const K & key) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+V& RedBlackTree<K,V,Augment,Compare,Index>::cursedInsert(const K & key) {
+    RedBlackNode* parentNode;
+    RedBlackNode* existingNode = _findSlot(key, parentNode);
+
+    // The value is written through the reference after this returns, so the index re-reads it later.
+    // Draining the queue once it outgrows the tree bounds it at O(n) and costs O(log n) amortized.
+    if constexpr (Index::ENABLED) {
+        if (_valueIndex.staleCount() > std::size_t(_size))
+            _refreshValueIndex();
+        _valueIndex.markStale(key);
+    }
 
-    if (!treeRoot) {
-        auto* newNode = new RedBlackNode(key);
-        // First node to be inserted into the tree
-        treeRoot = newNode;
-        treeRoot->color = BLACK;
-        ++_size;
-        return treeRoot->value;
+    // Key is in the tree, overwrite its value
+    if (existingNode) {
+        _indexErase(existingNode);
+        return existingNode->value;
     }
 
-    // Tree root exists, traverse to the appropriate node or leaf
-    RedBlackNode* currentNode = treeRoot;
-    RedBlackNode* parentNode;
-    bool nodeExists = false;
+    // Key is not in the tree, add as a leaf
+    RedBlackNode* newNode = _nodePool.create(key);
+    _attachNode(newNode, parentNode);
 
-    while (currentNode and !nodeExists) {
-        if (currentNode->key == key) {
-            nodeExists = true;
-            parentNode = currentNode->parent;
+    return newNode->value;
+}
 
-        } else if (currentNode->key > key) {
-            parentNode = currentNode;
-            currentNode = currentNode->leftChild;
 
-        } else {
-            parentNode = currentNode;
-            currentNode = currentNode->rightChild;
+/**
+ * Finds the value stored at a key is in the tree.
+ * @param key (K) - Key to find.
+ * @return - Returns a pointer to the value stored at a key, or nullptr if the key is not in the tree.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+V* RedBlackTree<K,V,Augment,Compare,Index>::findValue(const K & key) {
+    RedBlackNode* foundNode = _findNode(key);
+
+    if (!foundNode)   // Reached the end of a branch without finding the key
+        return nullptr;
+
+    return &foundNode->value;
+
+} // End findValue()
+
+
+/**
+ * Finds a key holding a value: O(1) expected with a HashValueIndex, otherwise an
+ * in-order scan in O(n). Values changed through an iterator or findValue() pointer
+ * are not seen by the index until they are set again with insert().
+ * @param value (V) - Value to search for. Needs ==.
+ * @return - Returns a pointer to a key holding the value (the smallest when scanning),
+ *           or nullptr if no key does. Valid until the tree next changes.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+const K* RedBlackTree<K,V,Augment,Compare,Index>::findKey(const V & value) {
+    if constexpr (Index::ENABLED) {
+        _refreshValueIndex();
+        return _valueIndex.find(value);
+    } else {
+        if (!treeRoot)
+            return nullptr;
+
+        for (RedBlackNode* currentNode = _findMinNode(treeRoot); currentNode; currentNode = _successor(currentNode)) {
+            if (currentNode->value == value)
+                return &currentNode->key;
         }
-    }
 
-    // Key is in the tree, overwrite its value
-    if (currentNode and currentNode->key == key) {
-        return currentNode->value;
+        return nullptr;
     }
 
-    // Key is not in the tree, add as a leaf
-    auto* newNode = new RedBlackNode(key);
-    newNode->parent = parentNode;
+} // End findKey()
 
-    if (key < parentNode->key) {
-        parentNode->leftChild = newNode;
+
+/**
+ * Finds every key holding a value, in O(m log m) for m matches with a HashValueIndex
+ * or O(n) otherwise.
+ * @param value (V) - Value to search for. Needs ==.
+ * @return - Returns the keys in ascending order.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+std::vector<K> RedBlackTree<K,V,Augment,Compare,Index>::findKeys(const V & value) {
+    std::vector<K> keys;
+
+    if constexpr (Index::ENABLED) {
+        _refreshValueIndex();
+        _valueIndex.findAll(value, keys);
+        std::sort(keys.begin(), keys.end(), _less);
     } else {
-        parentNode->rightChild = newNode;
+        visitInOrder([&](const K & key, const V & nodeValue) {
+            if (nodeValue == value)
+                keys.push_back(key);
+        });
     }
-    ++_size;
-    cout << _size;
-    return newNode->value;
+
+    return keys;
+
+} // End findKeys()
+
+
+/**
+ * @return Returns the approximate bytes held by the value index, or 0 without one.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+std::size_t RedBlackTree<K,V,Augment,Compare,Index>::valueIndexBytes() const {
+    if constexpr (Index::ENABLED)
+        return _valueIndex.bytesUsed();
+    else
+        return 0;
 }
 
 
 /**
- * Finds the value stored at a key is in the tree.
- * @param key (K) - Key to find.
- * @return - Returns a pointer to the value stored at a key.
+ * Removes a key from the tree.
+ * @param key - Key to be found and removed.
+ * @return - True if key existed within the tree, false if the key did not exist.
  */
-template <typename K, typename V>
-V& RedBlackTree<K,V>::findValue(const K & key) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+bool RedBlackTree<K,V,Augment,Compare,Index>::remove(const K & key) {
+    RedBlackNode* foundNode = _findNode(key);
+
+    if (!foundNode)
+        return false;
+
+    _removeNode(foundNode);
+    return true;
+}
+
+// ---------------------------------------------------------------------
+//                       Public Range Query Methods
+
+/**
+ * @param key - Key to search for.
+ * @return Returns an iterator to the largest key <= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::iterator RedBlackTree<K,V,Augment,Compare,Index>::floor(const K & key) {
+    RedBlackNode* floorNode;
+    RedBlackNode* ceilNode;
+    _bracket(key, floorNode, ceilNode);
+
+    return iterator(this, floorNode);
+}
+
+
+/**
+ * @param key - Key to search for.
+ * @return Returns an iterator to the smallest key >= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::iterator RedBlackTree<K,V,Augment,Compare,Index>::ceil(const K & key) {
+    return lower_bound(key);
+}
+
+
+// ---------------------------------------------------------------------
+//                     Public Order Statistic Methods
+
+/**
+ * Counts the keys less than a key in O(log n).
+ * @param key - Key to rank. Does not need to be in the tree.
+ * @return Returns the number of keys < key, which is key's position if it is in the tree.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+int RedBlackTree<K,V,Augment,Compare,Index>::rank(const K & key) {
+    static_assert(Augment::TRACKS_SIZE, "rank() needs a RedBlackTree with the OrderStatistics augmentation");
+
+    RedBlackNode* currentNode = treeRoot;
+    int keysBelow = 0;
+
+    while (currentNode) {
+        if (_less(currentNode->key, key)) {
+            // This node and its whole left subtree are smaller
+            keysBelow += Augment::size(currentNode->leftChild) + 1;
+            currentNode = currentNode->rightChild;
+        } else {
+            currentNode = currentNode->leftChild;
+        }
+    }
+
+    return keysBelow;
+}
+
+
+/**
+ * Finds the key at a position in sorted order in O(log n).
+ * @param position - 0 for the smallest key, size() - 1 for the largest.
+ * @return Returns an iterator to the key, or end() if position is out of range.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::iterator RedBlackTree<K,V,Augment,Compare,Index>::select(int position) {
+    static_assert(Augment::TRACKS_SIZE, "select() needs a RedBlackTree with the OrderStatistics augmentation");
+
+    if (position < 0 or position >= _size)
+        return end();
+
     RedBlackNode* currentNode = treeRoot;
-    bool nodeExists = false;
 
-    while (currentNode and !nodeExists) {
-        if (currentNode->key == key) {
-            nodeExists = true;
+    while (true) {
+        int leftSize = Augment::size(currentNode->leftChild);
+
+        if (position == leftSize)
+            return iterator(this, currentNode);
+
+        if (position < leftSize) {
+            currentNode = currentNode->leftChild;
+        } else {
+            position -= leftSize + 1;
+            currentNode = currentNode->rightChild;
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------
+//                     Public Range Aggregate Methods
 
-        } else if (currentNode->key > key) {
+/**
+ * Combines the values of every key in [low, high] in O(log n).
+ * Descends to the first node inside the range, then follows its two boundary paths,
+ * taking whole cached subtree summaries wherever a subtree lies inside the range.
+ * @param low, high - Inclusive key bounds.
+ * @return Returns the monoid combination of the values in key order, or identity() if none.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename A>
+typename A::value_type RedBlackTree<K,V,Augment,Compare,Index>::aggregate(const K & low, const K & high) {
+    static_assert(A::TRACKS_AGGREGATE, "aggregate() needs a RedBlackTree with the RangeAggregate augmentation");
+    using Monoid = typename A::Monoid;
+
+    // Find the highest node inside the range, where the two boundary paths split
+    RedBlackNode* splitNode = treeRoot;
+    while (splitNode and (_less(splitNode->key, low) or _less(high, splitNode->key)))
+        splitNode = _less(splitNode->key, low) ? splitNode->rightChild : splitNode->leftChild;
+
+    if (!splitNode)
+        return Monoid::identity();
+
+    // Keys >= low in the left subtree, found from the split outward (right to left)
+    typename A::value_type lowPart = Monoid::identity();
+    for (RedBlackNode* currentNode = splitNode->leftChild; currentNode; ) {
+        if (_less(currentNode->key, low)) {
+            currentNode = currentNode->rightChild;
+        } else {
+            lowPart = Monoid::combine(Monoid::combine(Monoid::fromValue(currentNode->value),
+                                                      A::summary(currentNode->rightChild)), lowPart);
             currentNode = currentNode->leftChild;
+        }
+    }
 
+    // Keys <= high in the right subtree, found from the split outward (left to right)
+    typename A::value_type highPart = Monoid::identity();
+    for (RedBlackNode* currentNode = splitNode->rightChild; currentNode; ) {
+        if (_less(high, currentNode->key)) {
+            currentNode = currentNode->leftChild;
         } else {
+            highPart = Monoid::combine(highPart, Monoid::combine(A::summary(currentNode->leftChild),
+                                                                 Monoid::fromValue(currentNode->value)));
             currentNode = currentNode->rightChild;
         }
     }
 
-    if (!currentNode)   // Reached the end of a branch and currentNode is a nullptr
-        return nullptr;
+    return Monoid::combine(Monoid::combine(lowPart, Monoid::fromValue(splitNode->value)), highPart);
 
-    return &currentNode->value;
+} // End aggregate()
 
-} // End findValue()
 
+// ---------------------------------------------------------------------
+//                      Public Lazy Update Methods
 
 /**
- * Finds whether a value is in the tree.
- * @param value (V) - Value to search for
- * @return - Returns the key for the value.
+ * Adds a delta to every value in O(1) by tagging the root.
+ * @param delta - Amount to add.
  */
-template <typename K, typename V>
-K RedBlackTree<K,V>::findKey(const V & value) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::addToAll(const V & delta) {
+    static_assert(Augment::HAS_LAZY_TAGS, "addToAll() needs a RedBlackTree with the LazyAdd augmentation");
 
-} // End findValue()
+    Augment::apply(treeRoot, delta);
+}
 
 
 /**
- * Removes a value from the tree.
- * @param value - Value to be found and removed.
- * @return - True if value existed within the tree, false if the value did not exist.
+ * Adds a delta to the value of every key in [low, high] in O(log n).
+ * Follows the same two boundary paths as aggregate(), adding to each boundary node
+ * inside the range and tagging each subtree that lies wholly inside it. Tags add up
+ * in any order, so nothing on the paths needs to be pushed down first.
+ * @param low, high - Inclusive key bounds.
+ * @param delta - Amount to add.
  */
-template <typename K, typename V>
-bool RedBlackTree<K,V>::remove(const K & key) {
-    return _remove(key, treeRoot);
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::addToRange(const K & low, const K & high, const V & delta) {
+    static_assert(Augment::HAS_LAZY_TAGS, "addToRange() needs a RedBlackTree with the LazyAdd augmentation");
+
+    RedBlackNode* splitNode = treeRoot;
+    while (splitNode and (_less(splitNode->key, low) or _less(high, splitNode->key)))
+        splitNode = _less(splitNode->key, low) ? splitNode->rightChild : splitNode->leftChild;
+
+    if (!splitNode)
+        return;
+
+    splitNode->value += delta;
+
+    // Keys >= low in the left subtree
+    for (RedBlackNode* currentNode = splitNode->leftChild; currentNode; ) {
+        if (_less(currentNode->key, low)) {
+            currentNode = currentNode->rightChild;
+        } else {
+            currentNode->value += delta;
+            Augment::apply(currentNode->rightChild, delta);
+            currentNode = currentNode->leftChild;
+        }
+    }
+
+    // Keys <= high in the right subtree
+    for (RedBlackNode* currentNode = splitNode->rightChild; currentNode; ) {
+        if (_less(high, currentNode->key)) {
+            currentNode = currentNode->leftChild;
+        } else {
+            currentNode->value += delta;
+            Augment::apply(currentNode->leftChild, delta);
+            currentNode = currentNode->rightChild;
+        }
+    }
+
+} // End addToRange()
+
+
+#ifdef CURSED_ARRAY_STATS
+// ---------------------------------------------------------------------
+//                          Public Stats Methods
+
+/**
+ * Measures the tree's current shape in O(n). Must not race with writers.
+ * @return Returns the height, black-height, node count, and bytes held by the tree.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::ShapeStats RedBlackTree<K,V,Augment,Compare,Index>::shape() {
+    ShapeStats treeShape{0, 0, _size, sizeof(*this) + _nodePool.bytesReserved() + valueIndexBytes()};
+
+    // Every root-to-leaf path has the same number of black nodes, so any one will do
+    for (RedBlackNode* currentNode = treeRoot; currentNode; currentNode = currentNode->leftChild)
+        treeShape.blackHeight += (currentNode->color == BLACK);
+
+    if (!treeRoot)
+        return treeShape;
+
+    // Count levels breadth-first
+    Queue<RedBlackNode*> levelNodes;
+    levelNodes.enqueue(treeRoot);
+
+    while (!levelNodes.isEmpty()) {
+        ++treeShape.height;
+
+        for (int levelWidth = levelNodes.size(); levelWidth > 0; --levelWidth) {
+            RedBlackNode* currentNode = levelNodes.deque();
+            if (currentNode->leftChild) { levelNodes.enqueue(currentNode->leftChild); }
+            if (currentNode->rightChild) { levelNodes.enqueue(currentNode->rightChild); }
+        }
+    }
+
+    return treeShape;
+
+} // End shape()
+
+
+/**
+ * Writes the operation counters and current shape as "name value" lines.
+ * @param out - Stream to write to.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::reportStats(std::ostream & out) {
+    ShapeStats treeShape = shape();
+
+    _stats.report(out);
+    out << "height " << treeShape.height
+        << "\nblack_height " << treeShape.blackHeight
+        << "\nnode_count " << treeShape.nodeCount
+        << "\nbytes_used " << treeShape.bytesUsed
+        << "\nvalue_index_bytes " << valueIndexBytes()
+        << '\n';
 }
+#endif // CURSED_ARRAY_STATS
+
+
+// ---------------------------------------------------------------------
+//                     Bulk Construction Methods
+
+/**
+ * Replaces the contents of the tree with a sorted range in O(n).
+ * The tree is built perfectly balanced; only the nodes on an incomplete bottom
+ * level are red, so no rotations or recoloring are needed.
+ * @param firstKey, lastKey - Keys in strictly ascending order.
+ * @param firstValue - Start of the values matching each key. Wrap in std::make_move_iterator to move them.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename KeyIt, typename ValueIt>
+void RedBlackTree<K,V,Augment,Compare,Index>::assignSorted(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue) {
+    clear();
+
+    int count = int(std::distance(firstKey, lastKey));
+    if (count == 0)
+        return;
+
+    // Levels above redDepth are full, nodes on level redDepth (if any) are red
+    int redDepth = 0;
+    while ((2 << redDepth) - 1 <= count)
+        ++redDepth;
+
+    treeRoot = _buildBalanced(firstKey, firstValue, count, 0, redDepth);
+    treeRoot->parent = nullptr;
+    _size = count;
+
+} // End assignSorted()
+
+
+/**
+ * Replaces the contents of the tree with an unsorted range.
+ * Pairs are sorted by key first, so this runs in O(n log n). If a key repeats,
+ * the last value for it wins, as if each pair had been inserted in turn.
+ * @param firstKey, lastKey - Keys in any order.
+ * @param firstValue - Start of the values matching each key.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename KeyIt, typename ValueIt>
+void RedBlackTree<K,V,Augment,Compare,Index>::assign(KeyIt firstKey, KeyIt lastKey, ValueIt firstValue) {
+    std::vector<K> keys(firstKey, lastKey);
+    std::vector<V> values;
+    values.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i, ++firstValue)
+        values.push_back(*firstValue);
+
+    std::vector<int> order(keys.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = int(i);
+
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return _less(keys[a], keys[b]); });
+
+    // Keep only the last of each run of equal keys
+    std::vector<K> sortedKeys;
+    std::vector<V> sortedValues;
+    sortedKeys.reserve(order.size());
+    sortedValues.reserve(order.size());
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 < order.size() and !_less(keys[order[i]], keys[order[i + 1]]))
+            continue;
+
+        sortedKeys.push_back(keys[order[i]]);
+        sortedValues.push_back(std::move(values[order[i]]));
+    }
+
+    assignSorted(sortedKeys.begin(), sortedKeys.end(), std::make_move_iterator(sortedValues.begin()));
+
+} // End assign()
 
 
 // ---------------------------------------------------------------------
 //                  Private Tree Management Methods
 
 /**
- * Private function to add a new node with a given value to the tree.
- * Called by the public insert function.
- * Duplicates are added in the left child.
- * @param value <V> - Value of the node to add.
- * @param root - Value of the current traversal node.
- * @return Returns a pointer to the current node.
+ * Iterative search for the node holding a key.
+ * @param key - Key to find.
+ * @return Returns the node with the key, or nullptr if the key is not in the tree.
  */
-template <typename K, typename V>
-V* RedBlackTree<K,V>::_insert(RedBlackNode* & parent, RedBlackNode* & newNode) {
-    V* valuePtr;
-        // Key > parent key, go right
-    if (newNode->key > parent->key) {
-
-        if (!parent->rightChild) {      // Parent does not have a right child
-            parent->rightChild = newNode;
-            valuePtr = &newNode->value;
-            newNode->parent = parent;
-            ++_size;
-        }
-        else {      // Parent has a right child, go to it
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::RedBlackNode* RedBlackTree<K,V,Augment,Compare,Index>::_findNode(const K & key) {
+    RedBlackNode* currentNode = treeRoot;
+    CURSED_STATS(uint64_t comparisons = 0);
 
-            valuePtr = _insert(parent->rightChild, newNode);
-        }
+    while (currentNode) {
+        _pushDown(currentNode);
+        CURSED_STATS(++comparisons);
+        int order = Compare::compare(key, currentNode->key);
+
+        if (order == 0)
+            break;
+        currentNode = (order < 0) ? currentNode->leftChild : currentNode->rightChild;
+    }
+
+    CURSED_STATS(_stats.add(_stats.lookups));
+    CURSED_STATS(_stats.add(_stats.comparisons, comparisons));
+    return currentNode;
+
+} // End _findNode()
+
+
+/**
+ * Descends to where a key is or would be placed.
+ * @param key - Key to place.
+ * @param parentNode - Set to the node a new key would hang from, or nullptr for an empty tree.
+ * @return Returns the node with the key if it exists, otherwise nullptr.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::RedBlackNode* RedBlackTree<K,V,Augment,Compare,Index>::_findSlot(const K & key, RedBlackNode* & parentNode) {
+    RedBlackNode* currentNode = treeRoot;
+    parentNode = nullptr;
+    CURSED_STATS(uint64_t comparisons = 0);
+
+    while (currentNode) {
+        _pushDown(currentNode);
+        CURSED_STATS(++comparisons);
+        int order = Compare::compare(key, currentNode->key);
+
+        if (order == 0)
+            break;
+        parentNode = currentNode;
+        currentNode = (order < 0) ? currentNode->leftChild : currentNode->rightChild;
+    }
 
-    } // end new key > parent key
+    CURSED_STATS(_stats.add(_stats.lookups));
+    CURSED_STATS(_stats.add(_stats.comparisons, comparisons));
+    return currentNode;
 
-        // key <= parent key, go left
-    else if (newNode->key < parent->key){
-        if (!parent->leftChild) {   // Parent does not have a left child
-            parent->leftChild = newNode;
-            valuePtr = &newNode->value;
-            newNode->parent = parent;
-            ++_size;
+} // End _findSlot()
+
+
+/**
+ * Single descent that finds the keys on either side of a key.
+ * @param key - Key to bracket.
+ * @param floorNode - Set to the node with the largest key <= key, or nullptr.
+ * @param ceilNode - Set to the node with the smallest key >= key, or nullptr.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_bracket(const K & key, RedBlackNode* & floorNode, RedBlackNode* & ceilNode) {
+    RedBlackNode* currentNode = treeRoot;
+    floorNode = nullptr;
+    ceilNode = nullptr;
+
+    while (currentNode) {
+        _pushDown(currentNode);
+        int order = Compare::compare(key, currentNode->key);
+
+        if (order == 0) {
+            floorNode = currentNode;
+            ceilNode = currentNode;
+            return;
         }
-        else {      // Parent has a left child, go to it
-            valuePtr = _insert(parent->leftChild, newNode);
+
+        if (order < 0) {
+            ceilNode = currentNode;
+            currentNode = currentNode->leftChild;
+        } else {
+            floorNode = currentNode;
+            currentNode = currentNode->rightChild;
         }
-    }   // end new key <= parent key
+    }
+
+} // End _bracket()
+
 
+/**
+ * Links a new red leaf under the parent found by _findSlot() and restores the red-black rules.
+ * @param newNode - Node to add. Must not already be in the tree.
+ * @param parentNode - Parent from _findSlot(), or nullptr if the tree is empty.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_attachNode(RedBlackNode* newNode, RedBlackNode* parentNode) {
+    newNode->parent = parentNode;
+    ++_size;
+    CURSED_STATS(_stats.add(_stats.inserts));
+
+    if (!parentNode) {
+        // First node to be inserted into the tree
+        treeRoot = newNode;
+        treeRoot->color = BLACK;
+        return;
+    }
+
+    if (_less(newNode->key, parentNode->key))
+        parentNode->leftChild = newNode;
+    else
+        parentNode->rightChild = newNode;
+
+    _updatePath(newNode);
     _checkColor(newNode);
 
-    return valuePtr;
-}   // end _insert()
+} // End _attachNode()
 
 
 /**
- * Recursive function to find and delete a key from the tree.
- * @param key - Value to be found and removed.
- * @param node - RedBlackNode* to the root of a tree or subtree.
- * @param isFound - Bool to be returned by calling function for whether key was found within the tree.
- * @return Returns true if the key to remove was found.
+ * Unlinks a node from the tree, frees it, and restores the red-black rules.
+ * A node with two children trades places with its in-order successor, so no keys
+ * or values are copied and pointers to other nodes stay valid.
+ * @param node - Node to remove.
  */
-template <typename K, typename V>
-bool RedBlackTree<K,V>::_remove(const K & key, RedBlackNode* node) {
-    // Base case 1: End of findValue, key not in tree
-    if (!node)
-        return false;
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_removeNode(RedBlackNode* node) {
+    RedBlackNode* replacement;      // Node that moves into the removed position (may be nullptr)
+    RedBlackNode* replacementParent;
+    bool removedColor = node->color;
+
+    if (!node->leftChild) {
+        replacement = node->rightChild;
+        replacementParent = node->parent;
+        _transplant(node, node->rightChild);
+
+    } else if (!node->rightChild) {
+        replacement = node->leftChild;
+        replacementParent = node->parent;
+        _transplant(node, node->leftChild);
+
+    } else {    // Parent of 2 children
+        RedBlackNode* successor = _findMinNode(node->rightChild);
+        removedColor = successor->color;
+        replacement = successor->rightChild;
+
+        if (successor->parent == node) {
+            replacementParent = successor;
+        } else {
+            replacementParent = successor->parent;
+            _transplant(successor, successor->rightChild);
+            successor->rightChild = node->rightChild;
+            successor->rightChild->parent = successor;
+        }
 
-    // Base case 2: Value found at this node.
-    // 3 Sub-cases: 1) Value found in a parent of 2 children
-    //              2) Value found in a parent of 1 child
-    //              3) Value found in a leaf
-    if (node->key == key) {
-        if (node->leftChild and node->rightChild) {      // Parent of 2 children
-            node->key = _findMinValue(node->rightChild);
-            _remove(node->key, node->rightChild);
+        _transplant(node, successor);
+        successor->leftChild = node->leftChild;
+        successor->leftChild->parent = successor;
+        successor->color = node->color;
+    }
 
-        } else if (node->leftChild or node->rightChild) {        // Parent of 1 child
-            RedBlackNode* tempNode = node;
-            node = (node->leftChild) ? node->leftChild : node->rightChild;
+    _indexErase(node);
+    _nodePool.destroy(node);
+    --_size;
+    CURSED_STATS(_stats.add(_stats.removes));
 
-            node->parent = tempNode->parent;
+    _updatePath(replacementParent);
 
-            if (tempNode->parent->leftChild == tempNode)
-                tempNode->parent->leftChild = node;
-            else
-                tempNode->parent->rightChild = node;
+    // Removing a red node never breaks a rule, removing a black one shortens a path
+    if (removedColor == BLACK)
+        _checkRemovedColor(replacement, replacementParent);
 
-            delete tempNode;
-            --_size;
+} // End _removeNode()
 
-        } else {    // Leaf
-            RedBlackNode* parent = node->parent;
 
-            if (parent->leftChild == node)
-                parent->leftChild = nullptr;
-            else
-                parent->rightChild = nullptr;
+/**
+ * Replaces the subtree rooted at one node with the subtree rooted at another.
+ * @param oldNode - Node whose position in its parent is taken over.
+ * @param newNode - Node to put in its place (may be nullptr).
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_transplant(RedBlackNode* oldNode, RedBlackNode* newNode) {
+    if (!oldNode->parent)
+        treeRoot = newNode;
+    else if (oldNode == oldNode->parent->leftChild)
+        oldNode->parent->leftChild = newNode;
+    else
+        oldNode->parent->rightChild = newNode;
 
-            delete node;
-            --_size;
-            node = parent;
-        }
+    if (newNode)
+        newNode->parent = oldNode->parent;
+}
 
-        _checkColor(node);
 
-        return true;
+/**
+ * Finds the node with the minimum key in a tree or subtree of a given root.
+ * @param root - Root of the tree or subtree to be searched. Must not be nullptr.
+ * @return Returns the minimum node.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::RedBlackNode* RedBlackTree<K,V,Augment,Compare,Index>::_findMinNode(RedBlackNode* root) {
+    _pushDown(root);
+    while (root->leftChild) {
+        root = root->leftChild;
+        _pushDown(root);     // The removal of a successor moves its children
     }
 
-    // Recursive case: Value higher or lower than current node's key
-    if (key < node->key) {
-        return _remove(key, node->leftChild);
-    } else {
-        return _remove(key, node->rightChild);
+    return root;
+
+} // End _findMinNode
+
+
+/**
+ * Finds the node with the maximum key in a tree or subtree of a given root.
+ * @param root - Root of the tree or subtree to be searched. Must not be nullptr.
+ * @return Returns the maximum node.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::RedBlackNode* RedBlackTree<K,V,Augment,Compare,Index>::_findMaxNode(RedBlackNode* root) {
+    _pushDown(root);
+    while (root->rightChild) {
+        root = root->rightChild;
+        _pushDown(root);
     }
 
-} // End _remove()
+    return root;
+
+} // End _findMaxNode
 
 
 /**
- * Finds the minimum value in a tree or subtree of a given root.
- * @param root - Root of the tree or subtree to be searched.
- * @return Returns the minimum value.
+ * Finds the next node in key order using parent pointers.
+ * @param node - Node to start from.
+ * @return Returns the next node, or nullptr if node holds the largest key.
  */
-template <typename K, typename V>
-K RedBlackTree<K,V>::_findMinValue(RedBlackNode* root ) {
-    // Base case 1: Tree does not exist
-    if (!root)
-        return -1;
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::RedBlackNode* RedBlackTree<K,V,Augment,Compare,Index>::_successor(RedBlackNode* node) {
+    // Successor is the leftmost node of the right subtree
+    _pushDown(node);
+    if (node->rightChild)
+        return _findMinNode(node->rightChild);
+
+    // Climb until we arrive from a left subtree
+    RedBlackNode* parentNode = node->parent;
+    while (parentNode and node == parentNode->rightChild) {
+        node = parentNode;
+        parentNode = parentNode->parent;
+    }
+
+    return parentNode;
+}
+
+
+/**
+ * Finds the previous node in key order using parent pointers.
+ * @param node - Node to start from.
+ * @return Returns the previous node, or nullptr if node holds the smallest key.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::RedBlackNode* RedBlackTree<K,V,Augment,Compare,Index>::_predecessor(RedBlackNode* node) {
+    // Predecessor is the rightmost node of the left subtree
+    _pushDown(node);
+    if (node->leftChild)
+        return _findMaxNode(node->leftChild);
 
-    // Base case 2: RedBlackNode has no left child, found min node
-    if (!root->leftChild) {
-        return root->key;
+    // Climb until we arrive from a right subtree
+    RedBlackNode* parentNode = node->parent;
+    while (parentNode and node == parentNode->leftChild) {
+        node = parentNode;
+        parentNode = parentNode->parent;
     }
 
-    // Recursive case: RedBlackNode has a left child
-    return _findMinValue(root->leftChild);
+    return parentNode;
+}
+
+
+/**
+ * Recursively builds a balanced subtree from the next count pairs of a sorted range.
+ * Nodes are created in key order, so the input iterators only ever move forward.
+ * @param nextKey, nextValue - Iterators to the next unused pair. Advanced past the subtree.
+ * @param count - Number of pairs in the subtree.
+ * @param depth - Depth of the subtree root in the whole tree.
+ * @param redDepth - Depth of the incomplete bottom level, whose nodes are colored red.
+ * @return Returns the root of the subtree, or nullptr if count is 0.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename KeyIt, typename ValueIt>
+typename RedBlackTree<K,V,Augment,Compare,Index>::RedBlackNode*
+RedBlackTree<K,V,Augment,Compare,Index>::_buildBalanced(KeyIt & nextKey, ValueIt & nextValue, int count, int depth, int redDepth) {
+    if (count == 0)
+        return nullptr;
+
+    int leftCount = (count - 1) / 2;
+    RedBlackNode* leftSubtree = _buildBalanced(nextKey, nextValue, leftCount, depth + 1, redDepth);
+
+    RedBlackNode* node = _nodePool.create(*nextKey, *nextValue, (depth == redDepth) ? RED : BLACK);
+    _indexAdd(node);
+    ++nextKey;
+    ++nextValue;
+
+    node->leftChild = leftSubtree;
+    if (leftSubtree)
+        leftSubtree->parent = node;
+
+    node->rightChild = _buildBalanced(nextKey, nextValue, count - 1 - leftCount, depth + 1, redDepth);
+    if (node->rightChild)
+        node->rightChild->parent = node;
+
+    Augment::update(node);
 
-} // End _findMinValue
+    return node;
+
+} // End _buildBalanced()
 
 
 /**
@@ -390,12 +1123,32 @@ K RedBlackTree<K,V>::_findMinValue(RedBlackNode* root ) {
  * @tparam V Value stored at given key.
  * @return Returns the number of elements in the array.
  */
-template <typename K, typename V>
-inline int RedBlackTree<K,V>::size() {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+inline int RedBlackTree<K,V,Augment,Compare,Index>::size() {
     return _size;
 }
 
 
+/**
+ * Removes every node from the tree.
+ * Node destructors only run when K or V own resources; the node memory itself is
+ * released a whole slab at a time.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::clear() {
+    if (!std::is_trivially_destructible<K>::value or !std::is_trivially_destructible<V>::value) {
+        if (treeRoot)
+            _postOrderTraverse(treeRoot, &RedBlackTree::_deleteNode);
+    }
+
+    _nodePool.releaseAll();
+    if constexpr (Index::ENABLED)
+        _valueIndex.clear();
+    treeRoot = nullptr;
+    _size = 0;
+}
+
+
 // ---------------------------------------------------------------------
 //                       Public Traversal Methods
 
@@ -405,8 +1158,8 @@ inline int RedBlackTree<K,V>::size() {
  * 2. Visit left subtree
  * 3. Visit right subtree
  **/
-template <typename K, typename V>
-void RedBlackTree<K,V>::preOrderTraverse() {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::preOrderTraverse() {
     _preOrderTraverse(treeRoot, &_printValue);
 }
 
@@ -417,8 +1170,8 @@ void RedBlackTree<K,V>::preOrderTraverse() {
  * 2. Visit root node
  * 3. Visit right subtree
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::inOrderTraverse() {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::inOrderTraverse() {
     _inOrderTraverse(treeRoot, &_printValue);
 }
 
@@ -429,8 +1182,8 @@ void RedBlackTree<K,V>::inOrderTraverse() {
  * 2. Visit right subtree
  * 3. Visit root node
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::postOrderTraverse() {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::postOrderTraverse() {
     _postOrderTraverse(treeRoot, &_printValue);
 }
 
@@ -438,13 +1191,125 @@ void RedBlackTree<K,V>::postOrderTraverse() {
 /**
  * Traverses the tree or subtree from in order of depth, from left to right.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::breadthFirstTraverse() {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::breadthFirstTraverse() {
     _breadthFirstTraverse(treeRoot, &_printValue);
 
 } // End breadthFirstTraverse()
 
 
+/**
+ * Visits every (key, value) pair in ascending key order.
+ * Follows parent pointers instead of recursing, so unbalanced trees cannot overflow the stack.
+ * @param visit - Called as visit(key, value).
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename Visitor>
+void RedBlackTree<K,V,Augment,Compare,Index>::visitInOrder(Visitor visit) {
+    if (!treeRoot)
+        return;
+
+    for (RedBlackNode* currentNode = _findMinNode(treeRoot); currentNode; currentNode = _successor(currentNode))
+        visit(currentNode->key, currentNode->value);
+
+} // End visitInOrder()
+
+
+/**
+ * Visits every (key, value) pair in order of depth, from left to right.
+ * @param visit - Called as visit(key, value).
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+template <typename Visitor>
+void RedBlackTree<K,V,Augment,Compare,Index>::visitBreadthFirst(Visitor visit) {
+    if (!treeRoot)
+        return;
+
+    Queue<RedBlackNode*> unvisitedNodes;
+    unvisitedNodes.enqueue(treeRoot);
+
+    while(!unvisitedNodes.isEmpty()) {
+        RedBlackNode* currentNode = unvisitedNodes.deque();
+        _pushDown(currentNode);
+
+        if (currentNode->leftChild) { unvisitedNodes.enqueue(currentNode->leftChild); }
+        if (currentNode->rightChild) { unvisitedNodes.enqueue(currentNode->rightChild); }
+
+        visit(currentNode->key, currentNode->value);
+    }
+
+} // End visitBreadthFirst()
+
+
+// ---------------------------------------------------------------------
+//                        Public Iterator Methods
+
+/**
+ * @return Returns an iterator to the smallest key, or end() if the tree is empty.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::iterator RedBlackTree<K,V,Augment,Compare,Index>::begin() {
+    return iterator(this, treeRoot ? _findMinNode(treeRoot) : nullptr);
+}
+
+
+/**
+ * @return Returns the past-the-end iterator.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::iterator RedBlackTree<K,V,Augment,Compare,Index>::end() {
+    return iterator(this, nullptr);
+}
+
+
+/**
+ * Finds the first key that is not less than a key in one descent.
+ * @param key - Key to search for.
+ * @return Returns an iterator to the first key >= key, or end() if there is none.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::iterator RedBlackTree<K,V,Augment,Compare,Index>::lower_bound(const K & key) {
+    RedBlackNode* currentNode = treeRoot;
+    RedBlackNode* bestNode = nullptr;
+
+    while (currentNode) {
+        _pushDown(currentNode);
+        if (_less(currentNode->key, key)) {
+            currentNode = currentNode->rightChild;
+        } else {
+            bestNode = currentNode;
+            currentNode = currentNode->leftChild;
+        }
+    }
+
+    return iterator(this, bestNode);
+}
+
+
+/**
+ * Finds the first key that is greater than a key in one descent.
+ * @param key - Key to search for.
+ * @return Returns an iterator to the first key > key, or end() if there is none.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+typename RedBlackTree<K,V,Augment,Compare,Index>::iterator RedBlackTree<K,V,Augment,Compare,Index>::upper_bound(const K & key) {
+    RedBlackNode* currentNode = treeRoot;
+    RedBlackNode* bestNode = nullptr;
+
+    while (currentNode) {
+        _pushDown(currentNode);
+        if (_less(key, currentNode->key)) {
+            bestNode = currentNode;
+            currentNode = currentNode->leftChild;
+        } else {
+            currentNode = currentNode->rightChild;
+        }
+    }
+
+    return iterator(this, bestNode);
+}
+
+
 // ---------------------------------------------------------------------
 //                       Private Traversal Methods
 //           Applies an operation (function) to each node during traversal.
@@ -454,8 +1319,10 @@ void RedBlackTree<K,V>::breadthFirstTraverse() {
  * @param root - The root of the tree or subtree to be traversed.
  * @param operation - Function to execute on each node.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_preOrderTraverse(RedBlackNode* & root, void(*operation)(RedBlackNode*)) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_preOrderTraverse(RedBlackNode* & root, void(*operation)(RedBlackNode*)) {
+    _pushDown(root);
+
     // Do something
     operation(root);
 
@@ -475,8 +1342,10 @@ void RedBlackTree<K,V>::_preOrderTraverse(RedBlackNode* & root, void(*operation)
  * @param root - The root of the tree or subtree to be traversed.
  * @param operation - Function to execute on each node.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_inOrderTraverse(RedBlackNode* & root, void(*operation)(RedBlackNode*)) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_inOrderTraverse(RedBlackNode* & root, void(*operation)(RedBlackNode*)) {
+    _pushDown(root);
+
     // Visit left child
     if (root->leftChild)
         _inOrderTraverse(root->leftChild, &_printValue);
@@ -496,8 +1365,8 @@ void RedBlackTree<K,V>::_inOrderTraverse(RedBlackNode* & root, void(*operation)(
  * @param root - The root of the tree or subtree to be traversed.
  * @param operation - Function to execute on each node.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_postOrderTraverse(RedBlackNode* & root, void(*operation)(RedBlackNode*)) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_postOrderTraverse(RedBlackNode* & root, void(*operation)(RedBlackNode*)) {
     // Visit left child
     if (root->leftChild)
         _postOrderTraverse(root->leftChild, operation);
@@ -517,13 +1386,17 @@ void RedBlackTree<K,V>::_postOrderTraverse(RedBlackNode* & root, void(*operation
  * @param root - Root of tree or subtree to evaluate.
  * @param operation - Pointer to a function to perform at each node.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_breadthFirstTraverse(RedBlackNode* root, void(*operation)(RedBlackNode*)) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_breadthFirstTraverse(RedBlackNode* root, void(*operation)(RedBlackNode*)) {
+    if (!root)
+        return;
+
     Queue<RedBlackNode*> unvisitedNodes;
     unvisitedNodes.enqueue(root);
 
     while(!unvisitedNodes.isEmpty()) {
         RedBlackNode* currentNode = unvisitedNodes.deque();
+        _pushDown(currentNode);
 
         if (currentNode->leftChild) { unvisitedNodes.enqueue(currentNode->leftChild); }
         if (currentNode->rightChild) { unvisitedNodes.enqueue(currentNode->rightChild); }
@@ -538,12 +1411,12 @@ void RedBlackTree<K,V>::_breadthFirstTraverse(RedBlackNode* root, void(*operatio
 //                       Traversal Operations
 
 /**
- * Deletes a node.
- * @param node - The node to delete.
+ * Destroys a node in place. Its memory is returned with the rest of the node pool.
+ * @param node - The node to destroy.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_deleteNode(RedBlackNode* node) {
-    delete node;
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_deleteNode(RedBlackNode* node) {
+    node->~RedBlackNode();
 }
 
 
@@ -551,8 +1424,8 @@ void RedBlackTree<K,V>::_deleteNode(RedBlackNode* node) {
  * Prints the value of node to console.
  * @param node - The node whose value will be printed to console.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_printValue(RedBlackNode* node) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_printValue(RedBlackNode* node) {
     cout << "( " << node->value << " | " << (node->color ? "R" : "B") << " ) ";
 }
 
@@ -561,8 +1434,8 @@ void RedBlackTree<K,V>::_printValue(RedBlackNode* node) {
  * Finds and sets the height of a node. Used in a breadth first findValue for AVL re-balancing.
  * @param node - RedBlackNode whose height needs to be evaluated.
  */
-template <typename K, typename T>
-void RedBlackTree<K,T>::_calcHeight(RedBlackNode* node) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_calcHeight(RedBlackNode* node) {
 
     if (node->leftChild && node->rightChild)
         node->height = std::max(node->leftChild->height, node->rightChild->height) + 1;
@@ -579,204 +1452,334 @@ void RedBlackTree<K,T>::_calcHeight(RedBlackNode* node) {
 }
 
 
+// ---------------------------------------------------------------------
+//                        Augmentation Upkeep
+
+/**
+ * Recomputes the augmented summary of a node and every ancestor above it.
+ * Compiles to nothing for NoAugment.
+ * @param node - Lowest node whose subtree changed (may be nullptr).
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_updatePath(RedBlackNode* node) {
+    if (std::is_same<Augment, NoAugment>::value)
+        return;
+
+    for (; node; node = node->parent)
+        Augment::update(node);
+}
+
+
+/**
+ * Pushes a node's lazy tag down to its children, so their values are current
+ * before the tree reads below the node or moves it. Compiles to nothing for
+ * policies without lazy tags.
+ * @param node - Node whose ancestors have all been pushed down.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+inline void RedBlackTree<K,V,Augment,Compare,Index>::_pushDown(RedBlackNode* node) {
+    if constexpr (Augment::HAS_LAZY_TAGS)
+        Augment::push(node);
+}
+
+
+// ---------------------------------------------------------------------
+//                        Value Index Upkeep
+
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+inline void RedBlackTree<K,V,Augment,Compare,Index>::_indexAdd(RedBlackNode* node) {
+    if constexpr (Index::ENABLED)
+        _valueIndex.add(node->value, node->key);
+}
+
+
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+inline void RedBlackTree<K,V,Augment,Compare,Index>::_indexErase(RedBlackNode* node) {
+    if constexpr (Index::ENABLED)
+        _valueIndex.erase(node->value, node->key);
+}
+
+
+/**
+ * Re-indexes the keys handed out by cursedInsert() since the last lookup, under
+ * whatever value was written through the reference. Keys removed since are skipped.
+ */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_refreshValueIndex() {
+    for (const K & key : _valueIndex.takeStale()) {
+        RedBlackNode* node = _findNode(key);
+        if (!node)
+            continue;
+
+        // Also drops an entry from an insert() after cursedInsert(), so the key is indexed once
+        _indexErase(node);
+        _indexAdd(node);
+    }
+}
+
+
 // ---------------------------------------------------------------------
 //                        Red-Black Re-balancing
 
 
 /**
- *
- * @tparam T
- * @param node
+ * Rotates a node down to the left; its right child takes its place.
+ * @param node - Node to rotate. Must have a right child.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_leftRotate(RedBlackNode* node) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_leftRotate(RedBlackNode* node) {
+    CURSED_STATS(_stats.add(_stats.rotations));
+
     RedBlackNode* temp = node->rightChild;
+    _pushDown(node);
+    _pushDown(temp);
     node->rightChild = temp->leftChild;
 
     if (node->rightChild)
         node->rightChild->parent = node;
 
-    temp->leftChild = node;
-    node->parent = temp;
+    temp->parent = node->parent;
 
-    if (!node->parent) {
+    if (!node->parent)
         // We are the root node
         treeRoot = temp;
-        temp->parent = nullptr;
-    } else {
-        // We are not the root node
-        temp->parent = node->parent;
+    else if (node == node->parent->leftChild)
+        // Node is the left child of its parent
+        node->parent->leftChild = temp;
+    else
+        // Node is the right child of its parent
+        node->parent->rightChild = temp;
 
-        if (node == temp->parent->leftChild)
-            // Node is the left child of its parent
-            temp->parent->leftChild = temp;
-        else
-            // Node is the right child of its parent
-            temp->parent->rightChild = temp;
+    temp->leftChild = node;
+    node->parent = temp;
 
+    // Node is now below temp, so its summary is recomputed first
+    Augment::update(node);
+    Augment::update(temp);
 
-    }
-
-}
+} // End _leftRotate
 
 
 /**
- *
- * @tparam T
- * @param node
+ * Rotates a node down to the right; its left child takes its place.
+ * @param node - Node to rotate. Must have a left child.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_rightRotate(RedBlackNode* node) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_rightRotate(RedBlackNode* node) {
+    CURSED_STATS(_stats.add(_stats.rotations));
+
     RedBlackNode* temp = node->leftChild;
+    _pushDown(node);
+    _pushDown(temp);
     node->leftChild = temp->rightChild;
 
     if (node->leftChild)
         node->leftChild->parent = node;
 
-    if (!node->parent) {
+    temp->parent = node->parent;
+
+    if (!node->parent)
         // We are the root node
         treeRoot = temp;
-        temp->parent = nullptr;
-    } else {
-        // We are not the root node
-        temp->parent = node->parent;
-
-        if (node == node->parent->leftChild)
-            // Node is the left child of its parent
-            temp->parent->leftChild = temp;
-        else if(node == node->parent->rightChild)
-            // Node is the right child of its parent
-            temp->parent->rightChild = temp;
-    }
+    else if (node == node->parent->leftChild)
+        // Node is the left child of its parent
+        node->parent->leftChild = temp;
+    else
+        // Node is the right child of its parent
+        node->parent->rightChild = temp;
 
     temp->rightChild = node;
     node->parent = temp;
 
+    Augment::update(node);
+    Augment::update(temp);
+
 } // End _rotateRight
 
 
 /**
- *
- * @tparam T
- * @param node
+ * Double rotation for a node whose left child has an inner (right) grandchild.
+ * The grandchild ends up in the node's position.
+ * @param node - Top of the three nodes being rotated.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_leftRightRotate(RedBlackNode* node) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_leftRightRotate(RedBlackNode* node) {
     _leftRotate(node->leftChild);
     _rightRotate(node);
 }
 
 
 /**
- *
- * @tparam T
- * @param node
+ * Double rotation for a node whose right child has an inner (left) grandchild.
+ * The grandchild ends up in the node's position.
+ * @param node - Top of the three nodes being rotated.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_rightLeftRotate(RedBlackNode* node) {
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_rightLeftRotate(RedBlackNode* node) {
     _rightRotate(node->rightChild);
     _leftRotate(node);
 }
 
 
 /**
- *
- * @tparam T
- * @param node
+ * Sets a node's color during re-balancing, counting real changes in stats builds.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_rotate(RedBlackNode* node) {
-    RedBlackNode* parentNode = node->parent;
-    RedBlackNode* grandparent = parentNode->parent;
-
-    if (node == parentNode->leftChild) {    // Node is left child of parent
-
-        if (parentNode == grandparent->leftChild) {     // Parent is left child of grandparent
-            _rightRotate(grandparent);
-            node->color = RED;
-            parentNode->color = BLACK;
-            if (parentNode->rightChild)
-                parentNode->rightChild->color = RED;
-            return;
-        }
-            // Parent is right child of grandparent
-        _rightLeftRotate(grandparent);
-        node->color = BLACK;    // Node is now the parent to the old parent and grandparent
-        node->rightChild->color = RED;
-        node->leftChild->color = RED;
-        return;
-    }
-
-    // Node is the right child of parent
-    if (parentNode == grandparent->rightChild) {
-        // Parent is the right child of the grandparent
-        _leftRotate(grandparent);
-        node->color = RED;
-        parentNode->color = BLACK;
-        if (parentNode->leftChild)
-            parentNode->leftChild->color = RED;
-        return;
-    }
-
-    // Parent is the left child of the grandparent
-    _leftRightRotate(grandparent);
-    node->color = BLACK;
-    node->rightChild->color = RED;
-    node->leftChild->color = RED;
-
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+inline void RedBlackTree<K,V,Augment,Compare,Index>::_recolor(RedBlackNode* node, bool color) {
+    CURSED_STATS(if (node->color != color) _stats.add(_stats.recolorings));
+    node->color = color;
 }
 
 
 /**
- *
- * @tparam T
- * @param node
+ * Restores the red-black rules after a red leaf is added.
+ * Recoloring moves a red-red conflict up two levels at a time; once the aunt is
+ * black, at most two rotations fix the tree and the loop stops there.
+ * @param node - Newly added red node.
  */
-template <typename K, typename V>
-void RedBlackTree<K,V>::_correctTree(RedBlackNode* node) {
-    RedBlackNode* parentNode = node->parent;
-    RedBlackNode* grandparent = (parentNode->parent) ? grandparent = parentNode->parent : nullptr;
-
-    if(!grandparent) {
-        return;     // There is no grandparent, there is no correcting necessary
-    }
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_checkColor(RedBlackNode* node) {
+    // Breaks 2 adjacent red node rule while the parent is red
+    while (node != treeRoot and node->parent->color == RED) {
+        RedBlackNode* parentNode = node->parent;
+        RedBlackNode* grandparent = parentNode->parent;     // Exists since the red parent is not the root
 
         // Aunt is the grandparent's opposite child to the parent
-    RedBlackNode* aunt = (parentNode == grandparent->leftChild) ? grandparent->rightChild : grandparent->leftChild;
-
-        // Aunt doesn't exist or is black
-    if (!aunt or aunt->color == BLACK) {
-        _rotate(node);
-        return;
-    }
+        RedBlackNode* aunt = (parentNode == grandparent->leftChild) ? grandparent->rightChild : grandparent->leftChild;
+
+        // Aunt is red, push the blackness down from the grandparent and continue above it
+        if (aunt and aunt->color == RED) {
+            _recolor(aunt, BLACK);
+            _recolor(parentNode, BLACK);
+            _recolor(grandparent, RED);
+            node = grandparent;
+            continue;
+        }
 
-        // Aunt findKey (not always true, can be nullptr) and is red
-    if (aunt) {
-        aunt->color = BLACK;
+        // Aunt doesn't exist or is black, rotate the middle key into the grandparent's place
+        if (parentNode == grandparent->leftChild) {
+            if (node == parentNode->rightChild) {
+                _leftRightRotate(grandparent);
+                _recolor(node, BLACK);
+            } else {
+                _rightRotate(grandparent);
+                _recolor(parentNode, BLACK);
+            }
+        } else {
+            if (node == parentNode->leftChild) {
+                _rightLeftRotate(grandparent);
+                _recolor(node, BLACK);
+            } else {
+                _leftRotate(grandparent);
+                _recolor(parentNode, BLACK);
+            }
+        }
+        _recolor(grandparent, RED);
+        break;
     }
-    grandparent->color = RED;
-    parentNode->color = BLACK;
-}
 
+    _recolor(treeRoot, BLACK);
+} // End _checkColor()
 
 
 /**
- *
- * @tparam T
- * @param colorCheck
+ * Restores the red-black rules after a black node is removed.
+ * The path through the removed position is one black node short; the loop pushes
+ * that deficit up the tree until it can be absorbed by a red node or fixed with
+ * at most three rotations.
+ * @param node - Node now in the removed position (may be nullptr).
+ * @param parentNode - Parent of that position.
  */
+template <typename K, typename V, typename Augment, typename Compare, typename Index>
+void RedBlackTree<K,V,Augment,Compare,Index>::_checkRemovedColor(RedBlackNode* node, RedBlackNode* parentNode) {
+    while (node != treeRoot and (!node or node->color == BLACK)) {
+        if (node == parentNode->leftChild) {
+            RedBlackNode* sibling = parentNode->rightChild;
+
+            // Red sibling, rotate so the sibling is black
+            if (sibling->color == RED) {
+                _recolor(sibling, BLACK);
+                _recolor(parentNode, RED);
+                _leftRotate(parentNode);
+                sibling = parentNode->rightChild;
+            }
+
+            bool leftBlack = !sibling->leftChild or sibling->leftChild->color == BLACK;
+            bool rightBlack = !sibling->rightChild or sibling->rightChild->color == BLACK;
+
+            // Sibling has only black children, move the deficit up to the parent
+            if (leftBlack and rightBlack) {
+                _recolor(sibling, RED);
+                node = parentNode;
+                parentNode = node->parent;
+                continue;
+            }
+
+            // Sibling's far child is black, rotate its red near child outward
+            if (rightBlack) {
+                _recolor(sibling->leftChild, BLACK);
+                _recolor(sibling, RED);
+                _rightRotate(sibling);
+                sibling = parentNode->rightChild;
+            }
+
+            _recolor(sibling, parentNode->color);
+            _recolor(parentNode, BLACK);
+            _recolor(sibling->rightChild, BLACK);
+            _leftRotate(parentNode);
+            node = treeRoot;
+
+        } else {    // Mirror image with left and right swapped
+            RedBlackNode* sibling = parentNode->leftChild;
+
+            if (sibling->color == RED) {
+                _recolor(sibling, BLACK);
+                _recolor(parentNode, RED);
+                _rightRotate(parentNode);
+                sibling = parentNode->leftChild;
+            }
+
+            bool leftBlack = !sibling->leftChild or sibling->leftChild->color == BLACK;
+            bool rightBlack = !sibling->rightChild or sibling->rightChild->color == BLACK;
+
+            if (leftBlack and rightBlack) {
+                _recolor(sibling, RED);
+                node = parentNode;
+                parentNode = node->parent;
+                continue;
+            }
+
+            if (leftBlack) {
+                _recolor(sibling->rightChild, BLACK);
+                _recolor(sibling, RED);
+                _leftRotate(sibling);
+                sibling = parentNode->leftChild;
+            }
+
+            _recolor(sibling, parentNode->color);
+            _recolor(parentNode, BLACK);
+            _recolor(sibling->leftChild, BLACK);
+            _rightRotate(parentNode);
+            node = treeRoot;
+        }
+    }
+
+    if (node)
+        _recolor(node, BLACK);
+} // End _checkRemovedColor()
+
+
+// RedBlackTree with subtree sizes, usable as CursedArray storage for rank()/select()
 template <typename K, typename V>
-void RedBlackTree<K,V>::_checkColor(RedBlackNode* node) {
-    if (node == treeRoot)   // Tree root has no parents and thus no conflicts.
-        return;
+using OrderStatisticTree = RedBlackTree<K, V, OrderStatistics>;
 
-    if (node->color == RED && node->parent->color == RED) { // Breaks 2 adjacent red node rule
-        _correctTree(node);
-    }
+// RedBlackTree with lazy value-add tags, usable as CursedArray storage for addToAll()/addToRange()
+template <typename K, typename V>
+using LazyAddTree = RedBlackTree<K, V, LazyAdd<V>>;
 
-    _checkColor(node->parent);
-    treeRoot->color = BLACK;
-} // End _checkColor()
+// RedBlackTree with a hash index from value to key, usable as CursedArray storage for findByValue()
+template <typename K, typename V>
+using ValueIndexedTree = RedBlackTree<K, V, NoAugment, KeyCompare<K>, HashValueIndex<K, V>>;
 
 
 #endif //REDBLACKTREE_H
@@ -0,0 +1,373 @@
+//   File: Sharded_CursedArray.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Key-range sharded CursedArray declarations and definitions.
+//         The float index space is split into shards, each a separately locked
+//         tree, so writers to different key ranges never contend. Shard
+//         boundaries are re-cut from the stored keys when shards drift out of
+//         balance, and ordered traversal walks the shards left to right.
+//         Shards store KeyTraits<float> encodings and route on them, as CursedArray
+//         does, so NaN and -0.0 indexes have a fixed place in the order.
+// ---------------------------------------------------------------------
+
+#ifndef SHARDED_CURSED_ARRAY_H
+#define SHARDED_CURSED_ARRAY_H
+
+#include "Key_Traits.h"
+#include "RedBlack_Tree.h"
+#include "ReadMostlyLock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+template <typename T, template <typename...> class Storage = RedBlackTree>
+class ShardedCursedArray {
+public:
+    // Snapshot of one shard's lock contention counters
+    struct ShardStats {
+        float lowIndex;             // Smallest index routed to the shard (-inf for shard 0)
+        int size;
+        long long acquisitions;     // Times the shard lock was taken
+        long long contended;        // Times the lock was already held and the caller waited
+        long long waitNanoseconds;  // Total time spent waiting on a held lock
+    };
+
+    static const int REBALANCE_CHECK_INTERVAL = 65536;   // Writes between balance checks
+
+private:
+    using Traits = KeyTraits<float>;
+    using EncodedKey = Traits::encoded_type;
+
+    struct Proxy {
+        ShardedCursedArray * _ca;
+        float _key;
+    public:
+        Proxy( ShardedCursedArray * ca, float key) : _ca(ca), _key(key) {}
+
+        operator T() const {
+            return _ca->get(_key);
+        }
+
+        void operator=(T value) {
+            _ca->set(_key, std::move(value));
+        }
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        Storage<EncodedKey, T> tree;
+        std::atomic<long long> acquisitions{0};
+        std::atomic<long long> contended{0};
+        std::atomic<long long> waitNanoseconds{0};
+    };
+
+    int _shardCount;
+    std::unique_ptr<Shard[]> _shards;
+    std::vector<EncodedKey> _boundaries;    // _boundaries[i] is the smallest encoded index of shard i + 1
+    ReadMostlyLock _boundaryLock;       // Shared by every operation, exclusive while re-cutting shards
+    std::atomic<long long> _writesSinceCheck{0};
+
+public:
+    // Constructors
+    explicit ShardedCursedArray(int shardCount = 16, float expectedLow = 0.f, float expectedHigh = 1.f);
+
+    Proxy operator [](float index) {
+        return Proxy(this, index);
+    }
+
+    // Array Management Methods
+    T get(float index);
+    void set(float index, T value);
+    bool remove(float index);
+    int size();
+
+    // Traversal Methods
+    template <typename Visitor>
+    void visitInOrder(Visitor visit);
+    template <typename Visitor>
+    void visitRange(float low, float high, Visitor visit);
+
+    // Shard Management Methods
+    void rebalance();
+    std::vector<ShardStats> shardStats();
+
+private:
+    int _shardFor(EncodedKey key);
+    std::unique_lock<std::mutex> _lockShard(Shard & shard);
+    void _checkBalance();
+};
+
+
+// ---------------------------------------------------------------------
+//                          Constructors
+
+/**
+ * Splits [expectedLow, expectedHigh) evenly between the shards until real keys arrive.
+ * @param shardCount - Number of independently locked shards.
+ * @param expectedLow, expectedHigh - Guess at the index range; rebalance() corrects it.
+ */
+template <typename T, template <typename...> class Storage>
+ShardedCursedArray<T, Storage>::ShardedCursedArray(int shardCount, float expectedLow, float expectedHigh) {
+    _shardCount = std::max(1, shardCount);
+    _shards.reset(new Shard[_shardCount]);
+
+    float width = (expectedHigh - expectedLow) / float(_shardCount);
+    for (int i = 1; i < _shardCount; ++i)
+        _boundaries.push_back(Traits::encode(expectedLow + width * float(i)));
+}
+
+
+// ---------------------------------------------------------------------
+//                  Public Array Management Methods
+
+/**
+ * @param index - Index to read.
+ * @return Returns a copy of the value, or a default value if the index is unset.
+ */
+template <typename T, template <typename...> class Storage>
+T ShardedCursedArray<T, Storage>::get(float index) {
+    EncodedKey key = Traits::encode(index);
+    std::shared_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+    Shard & shard = _shards[_shardFor(key)];
+    std::unique_lock<std::mutex> shardGuard = _lockShard(shard);
+
+    T* value = shard.tree.findValue(key);
+    return value ? *value : T();
+}
+
+
+/**
+ * @param index - Index to write.
+ * @param value - Value to store.
+ */
+template <typename T, template <typename...> class Storage>
+void ShardedCursedArray<T, Storage>::set(float index, T value) {
+    EncodedKey key = Traits::encode(index);
+    {
+        std::shared_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+        Shard & shard = _shards[_shardFor(key)];
+        std::unique_lock<std::mutex> shardGuard = _lockShard(shard);
+
+        shard.tree.insert(key, std::move(value));
+    }
+
+    if (_writesSinceCheck.fetch_add(1, std::memory_order_relaxed) + 1 == REBALANCE_CHECK_INTERVAL)
+        _checkBalance();
+}
+
+
+/**
+ * @param index - Index to remove.
+ * @return Returns true if the index was saved.
+ */
+template <typename T, template <typename...> class Storage>
+bool ShardedCursedArray<T, Storage>::remove(float index) {
+    EncodedKey key = Traits::encode(index);
+    std::shared_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+    Shard & shard = _shards[_shardFor(key)];
+    std::unique_lock<std::mutex> shardGuard = _lockShard(shard);
+
+    return shard.tree.remove(key);
+}
+
+
+/**
+ * @return Returns the number of saved indexes across all shards.
+ */
+template <typename T, template <typename...> class Storage>
+int ShardedCursedArray<T, Storage>::size() {
+    std::shared_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+    int total = 0;
+
+    for (int i = 0; i < _shardCount; ++i) {
+        std::unique_lock<std::mutex> shardGuard = _lockShard(_shards[i]);
+        total += _shards[i].tree.size();
+    }
+
+    return total;
+}
+
+
+// ---------------------------------------------------------------------
+//                       Public Traversal Methods
+
+/**
+ * Visits every (index, value) pair in ascending index order.
+ * Shards are locked one at a time, so writers to other shards keep running; the
+ * traversal is ordered but not a single atomic snapshot.
+ * @param visit - Called as visit(index, value).
+ */
+template <typename T, template <typename...> class Storage>
+template <typename Visitor>
+void ShardedCursedArray<T, Storage>::visitInOrder(Visitor visit) {
+    std::shared_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+
+    for (int i = 0; i < _shardCount; ++i) {
+        std::unique_lock<std::mutex> shardGuard = _lockShard(_shards[i]);
+        _shards[i].tree.visitInOrder([&](const EncodedKey & key, T & value) {
+            visit(Traits::decode(key), value);
+        });
+    }
+}
+
+
+/**
+ * Visits every (index, value) pair with index in [low, high] in ascending order,
+ * touching only the shards that overlap the range.
+ * @param low, high - Inclusive index bounds.
+ * @param visit - Called as visit(index, value).
+ */
+template <typename T, template <typename...> class Storage>
+template <typename Visitor>
+void ShardedCursedArray<T, Storage>::visitRange(float low, float high, Visitor visit) {
+    EncodedKey encodedLow = Traits::encode(low);
+    EncodedKey encodedHigh = Traits::encode(high);
+    std::shared_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+    int lastShard = _shardFor(encodedHigh);
+
+    for (int i = _shardFor(encodedLow); i <= lastShard; ++i) {
+        Shard & shard = _shards[i];
+        std::unique_lock<std::mutex> shardGuard = _lockShard(shard);
+
+        for (auto it = shard.tree.lower_bound(encodedLow); it != shard.tree.end() and !(encodedHigh < it.key()); ++it)
+            visit(Traits::decode(it.key()), it.value());
+    }
+}
+
+
+// ---------------------------------------------------------------------
+//                     Public Shard Management Methods
+
+/**
+ * Re-cuts the shard boundaries so every shard holds an equal share of the saved
+ * indexes, then moves pairs into their new shards with one O(n) bulk load each.
+ * Blocks all other operations while it runs.
+ */
+template <typename T, template <typename...> class Storage>
+void ShardedCursedArray<T, Storage>::rebalance() {
+    std::unique_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+
+    // Shards are ordered by range, so draining them in turn gives sorted pairs
+    std::vector<EncodedKey> keys;
+    std::vector<T> values;
+
+    for (int i = 0; i < _shardCount; ++i) {
+        std::lock_guard<std::mutex> shardGuard(_shards[i].mutex);
+        _shards[i].tree.visitInOrder([&](const EncodedKey & key, T & value) {
+            keys.push_back(key);
+            values.push_back(std::move(value));
+        });
+    }
+
+    if (keys.empty())
+        return;
+
+    size_t first = 0;
+    for (int i = 0; i < _shardCount; ++i) {
+        size_t last = keys.size() * size_t(i + 1) / size_t(_shardCount);
+
+        if (i > 0)
+            _boundaries[i - 1] = (first < keys.size()) ? keys[first] : keys.back();
+
+        std::lock_guard<std::mutex> shardGuard(_shards[i].mutex);
+        _shards[i].tree.assignSorted(keys.begin() + first, keys.begin() + last,
+                                     std::make_move_iterator(values.begin() + first));
+        first = last;
+    }
+
+    _writesSinceCheck.store(0, std::memory_order_relaxed);
+}
+
+
+/**
+ * @return Returns each shard's lower bound, size, and lock contention counters.
+ */
+template <typename T, template <typename...> class Storage>
+std::vector<typename ShardedCursedArray<T, Storage>::ShardStats> ShardedCursedArray<T, Storage>::shardStats() {
+    std::shared_lock<ReadMostlyLock> boundaryGuard(_boundaryLock);
+    std::vector<ShardStats> stats;
+
+    for (int i = 0; i < _shardCount; ++i) {
+        Shard & shard = _shards[i];
+        int shardSize;
+        {
+            std::lock_guard<std::mutex> shardGuard(shard.mutex);
+            shardSize = shard.tree.size();
+        }
+
+        stats.push_back({(i == 0) ? -std::numeric_limits<float>::infinity() : Traits::decode(_boundaries[i - 1]),
+                         shardSize,
+                         shard.acquisitions.load(std::memory_order_relaxed),
+                         shard.contended.load(std::memory_order_relaxed),
+                         shard.waitNanoseconds.load(std::memory_order_relaxed)});
+    }
+
+    return stats;
+}
+
+
+// ---------------------------------------------------------------------
+//                     Private Shard Management Methods
+
+/**
+ * @return Returns the shard whose range holds an encoded index. Caller holds _boundaryLock.
+ */
+template <typename T, template <typename...> class Storage>
+inline int ShardedCursedArray<T, Storage>::_shardFor(EncodedKey key) {
+    return int(std::upper_bound(_boundaries.begin(), _boundaries.end(), key) - _boundaries.begin());
+}
+
+
+/**
+ * Locks a shard, counting the acquisition and timing it if the lock was already held.
+ * @return Returns the held lock.
+ */
+template <typename T, template <typename...> class Storage>
+std::unique_lock<std::mutex> ShardedCursedArray<T, Storage>::_lockShard(Shard & shard) {
+    shard.acquisitions.fetch_add(1, std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> guard(shard.mutex, std::try_to_lock);
+    if (guard.owns_lock())
+        return guard;
+
+    auto waitStart = std::chrono::steady_clock::now();
+    guard.lock();
+    auto waited = std::chrono::steady_clock::now() - waitStart;
+
+    shard.contended.fetch_add(1, std::memory_order_relaxed);
+    shard.waitNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count(),
+                                    std::memory_order_relaxed);
+    return guard;
+}
+
+
+/**
+ * Rebalances when the largest shard holds more than twice its even share.
+ */
+template <typename T, template <typename...> class Storage>
+void ShardedCursedArray<T, Storage>::_checkBalance() {
+    std::vector<ShardStats> stats = shardStats();
+    int total = 0;
+    int largest = 0;
+
+    for (const ShardStats & shard : stats) {
+        total += shard.size;
+        largest = std::max(largest, shard.size);
+    }
+
+    if (_shardCount > 1 and largest > 2 * (total / _shardCount) + 1)
+        rebalance();
+    else
+        _writesSinceCheck.store(0, std::memory_order_relaxed);
+}
+
+
+#endif //SHARDED_CURSED_ARRAY_H
@@ -0,0 +1,390 @@
+//   File: Unrolled_List.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Header file for the UnrolledList class.
+//         A List whose nodes each hold a contiguous chunk of up to about sqrt(n)
+//         values, so positional insert, remove, and access skip whole chunks and
+//         cost O(sqrt n) instead of O(n). Chunks are re-cut as n grows or shrinks.
+//         Contains Chunk and UnrolledList declarations and definitions (due to templating).
+// ---------------------------------------------------------------------
+
+#ifndef UNROLLED_LIST_DATATYPE
+#define UNROLLED_LIST_DATATYPE
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class UnrolledList {
+
+protected:
+    struct Chunk {
+        std::vector<T> values;
+        Chunk* nextChunk;
+        Chunk* prevChunk;
+
+        explicit Chunk(int capacity, Chunk* next = nullptr, Chunk* prev = nullptr)
+            : nextChunk{next}, prevChunk{prev} { values.reserve(capacity); }
+    };
+
+    // Smallest chunk capacity; keeps chunks at least a few cache lines long for small lists
+    static const int MIN_CAPACITY = (256 / sizeof(T) > 8) ? int(256 / sizeof(T)) : 8;
+
+    // Member Data
+    Chunk* headChunk;
+    Chunk* tailChunk;
+    int _size;
+    int chunkCapacity;      // Chunks split when they reach this; about sqrt(_size)
+
+public:
+    // Forward iterator over the values in list order
+    class iterator {
+        friend class UnrolledList;
+        Chunk* _chunk;      // nullptr for end()
+        int _index;
+
+        iterator(Chunk* chunk, int index) : _chunk{chunk}, _index{index} {}
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() : _chunk{nullptr}, _index{0} {}
+
+        T & operator*() const { return _chunk->values[_index]; }
+        T * operator->() const { return &_chunk->values[_index]; }
+
+        iterator & operator++() {
+            if (++_index == int(_chunk->values.size())) {
+                _chunk = _chunk->nextChunk;
+                _index = 0;
+            }
+            return *this;
+        }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+
+        bool operator==(const iterator & other) const { return _chunk == other._chunk and _index == other._index; }
+        bool operator!=(const iterator & other) const { return !(*this == other); }
+    };
+
+    // Constructors
+    UnrolledList();
+    ~UnrolledList();
+    UnrolledList(const UnrolledList &) = delete;
+    UnrolledList & operator =(const UnrolledList &) = delete;
+
+    // Member Functions
+    bool insert(T data, int index);
+    T remove(int index);
+    T & valueAt(int index);
+    int findIndex(const T & data);
+    void makeEmpty();
+    [[nodiscard]] int size() const;
+
+    // Iterator Methods
+    iterator begin();
+    iterator end();
+
+protected:
+    Chunk* _findChunk(int & index);
+    void _splitChunk(Chunk* chunk);
+    bool _mergeIfSmall(Chunk* chunk);
+    void _unlinkChunk(Chunk* chunk);
+    void _resizeChunks();
+};
+
+
+// -----------------------------------------------------------------------------
+// Function Definitions
+// -----------------------------------------------------------------------------
+
+/**
+ * Default Constructor
+ */
+template <typename T>
+UnrolledList<T>::UnrolledList() {
+    headChunk = nullptr;
+    tailChunk = nullptr;
+    _size = 0;
+    chunkCapacity = MIN_CAPACITY;
+}
+
+
+/**
+ * Destructor
+ */
+template <typename T>
+UnrolledList<T>::~UnrolledList() {
+    makeEmpty();
+}
+
+
+/**
+ * Returns the _size of the list.
+ * @return (int) The _size of the list (last position = n - 1).
+ */
+template <typename T>
+inline int UnrolledList<T>::size() const {
+    return _size;
+} // end size
+
+
+/**
+ * Deletes each chunk in the list, resulting in a list with no values.
+ */
+template <typename T>
+void UnrolledList<T>::makeEmpty() {
+    while (headChunk) {
+        Chunk* tempChunk = headChunk;
+        headChunk = headChunk->nextChunk;
+
+        delete tempChunk;
+    }
+
+    tailChunk = nullptr;
+    _size = 0;
+    chunkCapacity = MIN_CAPACITY;
+} // end makeEmpty
+
+
+/**
+ * Adds a value at the given index in O(sqrt n).
+ * @param data - The value to be added.
+ * @param index - The index for the new value to be placed.
+ * @return (bool) True if the given index is within the list. False the given
+ * index is outside of the list.
+ */
+template <typename T>
+bool UnrolledList<T>::insert(T data, int index) {
+    // Index out of bounds
+    if (index < 0 || index > _size)
+        return false;
+
+    Chunk* chunk;
+
+    // List has no chunks
+    if (!headChunk) {
+        chunk = new Chunk(chunkCapacity);
+        headChunk = chunk;
+        tailChunk = chunk;
+    }
+    // Append to the last chunk
+    else if (index == _size) {
+        chunk = tailChunk;
+        index = int(chunk->values.size());
+    }
+    else {
+        chunk = _findChunk(index);
+    }
+
+    chunk->values.insert(chunk->values.begin() + index, std::move(data));
+    _size++;
+
+    if (int(chunk->values.size()) >= chunkCapacity)
+        _splitChunk(chunk);
+    _resizeChunks();
+
+    return true;
+} // end insert
+
+
+/**
+ * Deletes the value at the given index in O(sqrt n). The index must be within the list.
+ * @param index - Index at which to delete a value.
+ * @return Returns the value that was deleted.
+ */
+template <typename T>
+T UnrolledList<T>::remove( int index ) {
+    Chunk* chunk = _findChunk(index);
+
+    T tempValue = std::move(chunk->values[index]);
+    chunk->values.erase(chunk->values.begin() + index);
+    _size--;
+
+    // Keep every pair of neighbouring chunks at least half full, so there are O(n / capacity) chunks
+    if (chunk->values.empty()) {
+        _unlinkChunk(chunk);
+    } else {
+        Chunk* prevChunk = chunk->prevChunk;
+        if (prevChunk and _mergeIfSmall(prevChunk))
+            chunk = prevChunk;
+        _mergeIfSmall(chunk);
+    }
+    _resizeChunks();
+
+    return tempValue;
+} // end remove
+
+
+/**
+ * Searches the list for the given value.
+ * @param data - The value to search the list for.
+ * @return (int) The index of the first matching value or -1 if the
+ * value was not found within the list.
+ */
+template <typename T>
+int UnrolledList<T>::findIndex( const T & data ) {
+    int index = 0;
+
+    for (Chunk* chunk = headChunk; chunk; chunk = chunk->nextChunk) {
+        for (const T & value : chunk->values) {
+            if (value == data)
+                return index;
+            index++;
+        }
+    }
+
+    return -1;
+} // end findIndex
+
+
+/**
+ * Returns the value at the given index in O(sqrt n). The index must be within the list.
+ * @param index - The index of the value to retrieve.
+ * @return A reference to the value.
+ */
+template <typename T>
+T & UnrolledList<T>::valueAt( int index ) {
+    Chunk* chunk = _findChunk(index);
+    return chunk->values[index];
+}
+
+
+template <typename T>
+typename UnrolledList<T>::iterator UnrolledList<T>::begin() {
+    return iterator(headChunk, 0);
+}
+
+
+template <typename T>
+typename UnrolledList<T>::iterator UnrolledList<T>::end() {
+    return iterator(nullptr, 0);
+}
+
+
+/**
+ * Finds the chunk holding a list index, walking from whichever end is closer.
+ * @param index - List index on entry; index within the returned chunk on return.
+ * @return Returns the chunk holding the index.
+ */
+template <typename T>
+typename UnrolledList<T>::Chunk* UnrolledList<T>::_findChunk(int & index) {
+    Chunk* chunk;
+
+    if (index < _size / 2) {
+        chunk = headChunk;
+        while (index >= int(chunk->values.size())) {
+            index -= int(chunk->values.size());
+            chunk = chunk->nextChunk;
+        }
+    } else {
+        chunk = tailChunk;
+        int chunkStart = _size - int(chunk->values.size());
+        while (index < chunkStart) {
+            chunk = chunk->prevChunk;
+            chunkStart -= int(chunk->values.size());
+        }
+        index -= chunkStart;
+    }
+
+    return chunk;
+}
+
+
+/**
+ * Moves the back half of a full chunk into a new chunk after it.
+ */
+template <typename T>
+void UnrolledList<T>::_splitChunk(Chunk* chunk) {
+    Chunk* newChunk = new Chunk(chunkCapacity, chunk->nextChunk, chunk);
+    auto middle = chunk->values.begin() + chunk->values.size() / 2;
+
+    std::move(middle, chunk->values.end(), std::back_inserter(newChunk->values));
+    chunk->values.erase(middle, chunk->values.end());
+
+    if (chunk->nextChunk)
+        chunk->nextChunk->prevChunk = newChunk;
+    else
+        tailChunk = newChunk;
+    chunk->nextChunk = newChunk;
+}
+
+
+/**
+ * Folds the chunk after the given one into it when together they are under half capacity.
+ * @return Returns true if the chunks were merged.
+ */
+template <typename T>
+bool UnrolledList<T>::_mergeIfSmall(Chunk* chunk) {
+    Chunk* nextChunk = chunk->nextChunk;
+    if (!nextChunk or int(chunk->values.size() + nextChunk->values.size()) >= chunkCapacity / 2)
+        return false;
+
+    std::move(nextChunk->values.begin(), nextChunk->values.end(), std::back_inserter(chunk->values));
+    _unlinkChunk(nextChunk);
+    return true;
+}
+
+
+template <typename T>
+void UnrolledList<T>::_unlinkChunk(Chunk* chunk) {
+    if (chunk->prevChunk)
+        chunk->prevChunk->nextChunk = chunk->nextChunk;
+    else
+        headChunk = chunk->nextChunk;
+
+    if (chunk->nextChunk)
+        chunk->nextChunk->prevChunk = chunk->prevChunk;
+    else
+        tailChunk = chunk->prevChunk;
+
+    delete chunk;
+}
+
+
+/**
+ * Re-cuts every chunk to about sqrt(n) values once n has moved far enough that the
+ * current chunk capacity no longer gives O(sqrt n) operations. Each re-cut is O(n)
+ * and is preceded by Omega(n) operations, so the cost is amortized O(1).
+ */
+template <typename T>
+void UnrolledList<T>::_resizeChunks() {
+    int target = int(std::sqrt(double(_size))) + 1;
+    if (target < MIN_CAPACITY)
+        target = MIN_CAPACITY;
+
+    if (target <= chunkCapacity * 2 and target * 2 >= chunkCapacity)
+        return;
+
+    chunkCapacity = target;
+    int fill = chunkCapacity / 2 > 0 ? chunkCapacity / 2 : 1;   // Leave room to grow before splitting
+
+    Chunk* oldChunk = headChunk;
+    headChunk = nullptr;
+    tailChunk = nullptr;
+
+    while (oldChunk) {
+        for (T & value : oldChunk->values) {
+            if (!tailChunk or int(tailChunk->values.size()) == fill) {
+                Chunk* newChunk = new Chunk(chunkCapacity, nullptr, tailChunk);
+                if (tailChunk)
+                    tailChunk->nextChunk = newChunk;
+                else
+                    headChunk = newChunk;
+                tailChunk = newChunk;
+            }
+            tailChunk->values.push_back(std::move(value));
+        }
+
+        Chunk* tempChunk = oldChunk;
+        oldChunk = oldChunk->nextChunk;
+        delete tempChunk;
+    }
+}
+
+#endif //UNROLLED_LIST_DATATYPE
@@ -0,0 +1,149 @@
+//   File: Value_Index.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Optional secondary indexes from a value back to the keys holding it.
+//         RedBlackTree keeps the index in step with insert(), cursedInsert(), and
+//         remove(), which makes findKey() O(1) expected instead of a full scan.
+//         A value written through a cursedInsert() reference is only seen by the
+//         tree later, so those keys are queued as stale and re-read on the next lookup,
+//         or sooner once the queue outgrows the tree.
+// ---------------------------------------------------------------------
+
+#ifndef VALUE_INDEX_H
+#define VALUE_INDEX_H
+
+#include "Key_Traits.h"
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Default: no index. findKey() scans the tree in O(n).
+ */
+struct NoValueIndex {
+    static constexpr bool ENABLED = false;
+};
+
+
+/**
+ * Hash map from value to the set of keys holding it. Each key has at most one entry,
+ * and adding or erasing one is O(1) expected however many keys share its value.
+ * @tparam Hash - Hash for V; V also needs ==.
+ * @tparam KeyHash - Hash for K, consistent with Compare.
+ */
+template <typename K, typename V, typename Hash = std::hash<V>, typename Compare = KeyCompare<K>,
+          typename KeyHash = std::hash<K>>
+class HashValueIndex {
+public:
+    static constexpr bool ENABLED = true;
+
+private:
+    struct KeyEqual {
+        bool operator()(const K & a, const K & b) const { return Compare::compare(a, b) == 0; }
+    };
+    using KeySet = std::unordered_set<K, KeyHash, KeyEqual>;
+
+    std::unordered_map<V, KeySet, Hash> _keysByValue;
+    std::size_t _entryCount = 0;
+    std::vector<K> _staleKeys;      // Keys whose value may have changed since they were indexed
+
+public:
+    void add(const V & value, const K & key);
+    void erase(const V & value, const K & key);
+    void markStale(const K & key) { _staleKeys.push_back(key); }
+    std::size_t staleCount() const { return _staleKeys.size(); }
+    std::vector<K> takeStale();
+    void clear();
+
+    const K* find(const V & value) const;
+    void findAll(const V & value, std::vector<K> & keys) const;
+    std::size_t size() const { return _entryCount; }
+    std::size_t bytesUsed() const;
+};
+
+
+template <typename K, typename V, typename Hash, typename Compare, typename KeyHash>
+void HashValueIndex<K,V,Hash,Compare,KeyHash>::add(const V & value, const K & key) {
+    _entryCount += _keysByValue[value].insert(key).second;
+}
+
+
+/**
+ * Removes the entry for a key, if it is indexed under that value.
+ */
+template <typename K, typename V, typename Hash, typename Compare, typename KeyHash>
+void HashValueIndex<K,V,Hash,Compare,KeyHash>::erase(const V & value, const K & key) {
+    auto keys = _keysByValue.find(value);
+    if (keys == _keysByValue.end())
+        return;
+
+    _entryCount -= keys->second.erase(key);
+    if (keys->second.empty())
+        _keysByValue.erase(keys);
+}
+
+
+/**
+ * @return Returns the stale keys, leaving none queued. A key may appear more than once.
+ */
+template <typename K, typename V, typename Hash, typename Compare, typename KeyHash>
+std::vector<K> HashValueIndex<K,V,Hash,Compare,KeyHash>::takeStale() {
+    std::vector<K> staleKeys;
+    staleKeys.swap(_staleKeys);
+    return staleKeys;
+}
+
+
+template <typename K, typename V, typename Hash, typename Compare, typename KeyHash>
+void HashValueIndex<K,V,Hash,Compare,KeyHash>::clear() {
+    _keysByValue.clear();
+    _entryCount = 0;
+    _staleKeys.clear();
+}
+
+
+/**
+ * @return Returns one key holding the value, or nullptr if none does.
+ */
+template <typename K, typename V, typename Hash, typename Compare, typename KeyHash>
+const K* HashValueIndex<K,V,Hash,Compare,KeyHash>::find(const V & value) const {
+    auto keys = _keysByValue.find(value);
+    return (keys == _keysByValue.end()) ? nullptr : &*keys->second.begin();
+}
+
+
+/**
+ * Appends every key holding the value, in no particular order.
+ */
+template <typename K, typename V, typename Hash, typename Compare, typename KeyHash>
+void HashValueIndex<K,V,Hash,Compare,KeyHash>::findAll(const V & value, std::vector<K> & keys) const {
+    auto matches = _keysByValue.find(value);
+    if (matches != _keysByValue.end())
+        keys.insert(keys.end(), matches->second.begin(), matches->second.end());
+}
+
+
+/**
+ * Estimates the memory held by the index: the bucket arrays, one heap node per
+ * distinct value and per key (each with a next pointer and cached hash), and the
+ * stale key queue.
+ */
+template <typename K, typename V, typename Hash, typename Compare, typename KeyHash>
+std::size_t HashValueIndex<K,V,Hash,Compare,KeyHash>::bytesUsed() const {
+    std::size_t nodeOverhead = sizeof(void*) + sizeof(std::size_t);
+    std::size_t bytes = sizeof(*this)
+                        + _keysByValue.bucket_count() * sizeof(void*)
+                        + _keysByValue.size() * (sizeof(std::pair<const V, KeySet>) + nodeOverhead)
+                        + _entryCount * (sizeof(K) + nodeOverhead)
+                        + _staleKeys.capacity() * sizeof(K);
+
+    for (const auto & keys : _keysByValue)
+        bytes += keys.second.bucket_count() * sizeof(void*);
+    return bytes;
+}
+
+
+#endif //VALUE_INDEX_H
@@ -0,0 +1,125 @@
+//   File: concurrent_bench.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Multi-threaded throughput benchmark for ConcurrentCursedArray.
+//         Compares ReadMostlyLock against std::shared_mutex and a plain mutex
+//         for a read-only mix, mixes with a share of writes, and all writes.
+//         ShardedCursedArray runs the same mixes to show writer scaling.
+//   Usage: concurrent_bench [maxThreads] [keys] [millisecondsPerRun]
+// ---------------------------------------------------------------------
+
+#include "../Concurrent_CursedArray.h"
+#include "../Sharded_CursedArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+using std::chrono::steady_clock;
+
+// A plain mutex that also takes "shared" locks exclusively, i.e. one global lock
+struct GlobalMutex : std::mutex {
+    void lock_shared() { lock(); }
+    void unlock_shared() { unlock(); }
+};
+
+
+/**
+ * Runs threadCount threads against one array for a fixed time.
+ * @param array - Any array whose operator[] is safe to call from several threads.
+ * @param writePercent - Share of operations that are writes (0-100).
+ * @return Returns the total operations per second across all threads.
+ */
+template <typename Array>
+double runMix(Array & array, int threadCount, int keyCount, int writePercent, int milliseconds) {
+    for (int i = 0; i < keyCount; ++i)
+        array[float(i)] = i;
+
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::vector<long long> opCounts(threadCount * 16, 0);   // Spaced out to avoid false sharing
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(t + 1);
+            long long ops = 0;
+            long long checksum = 0;
+
+            while (!start.load())
+                std::this_thread::yield();
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                float key = float(rng() % keyCount);
+
+                if (int(rng() % 100) < writePercent)
+                    array[key] = int(ops);
+                else
+                    checksum += int(array[key]);
+                ++ops;
+            }
+
+            opCounts[t * 16] = ops + (checksum == -1);
+        });
+    }
+
+    auto begin = steady_clock::now();
+    start.store(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop.store(true);
+    for (std::thread & thread : threads)
+        thread.join();
+    double seconds = std::chrono::duration<double>(steady_clock::now() - begin).count();
+
+    long long totalOps = 0;
+    for (int t = 0; t < threadCount; ++t)
+        totalOps += opCounts[t * 16];
+
+    return double(totalOps) / seconds;
+}
+
+
+template <typename Lock>
+double runLocked(int threadCount, int keyCount, int writePercent, int milliseconds) {
+    ConcurrentCursedArray<int, RedBlackTree, Lock> array;
+    return runMix(array, threadCount, keyCount, writePercent, milliseconds);
+}
+
+
+// One shard per thread, split over the key range up front
+double runSharded(int threadCount, int keyCount, int writePercent, int milliseconds) {
+    ShardedCursedArray<int> array(threadCount, 0.f, float(keyCount));
+    return runMix(array, threadCount, keyCount, writePercent, milliseconds);
+}
+
+
+int main(int argc, char* argv[]) {
+    int maxThreads = (argc > 1) ? std::atoi(argv[1]) : int(std::max(1u, std::thread::hardware_concurrency()));
+    int keyCount = (argc > 2) ? std::atoi(argv[2]) : 100000;
+    int milliseconds = (argc > 3) ? std::atoi(argv[3]) : 300;
+
+    std::printf("lock,threads,write_percent,mops_per_sec\n");
+
+    for (int writePercent : {0, 1, 10, 100}) {
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            std::printf("ReadMostlyLock,%d,%d,%.3f\n", threads, writePercent,
+                        runLocked<ReadMostlyLock>(threads, keyCount, writePercent, milliseconds) / 1e6);
+            std::printf("shared_mutex,%d,%d,%.3f\n", threads, writePercent,
+                        runLocked<std::shared_mutex>(threads, keyCount, writePercent, milliseconds) / 1e6);
+            std::printf("mutex,%d,%d,%.3f\n", threads, writePercent,
+                        runLocked<GlobalMutex>(threads, keyCount, writePercent, milliseconds) / 1e6);
+            std::printf("sharded,%d,%d,%.3f\n", threads, writePercent,
+                        runSharded(threads, keyCount, writePercent, milliseconds) / 1e6);
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
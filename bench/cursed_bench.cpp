@@ -0,0 +1,273 @@
+//   File: cursed_bench.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Single-threaded microbenchmarks for RedBlackTree and CursedArray.
+//         Times insert, lookup hit/miss, in-order scan, breadth-first traversal,
+//         and remove for sizes from 1e3 up to maxSize, over uniform, sorted, and
+//         clustered float keys, against std::map and std::unordered_map.
+//         Keys come from a fixed seed, so runs are reproducible. Each figure is
+//         the best of several repeats for small sizes.
+//   Usage: cursed_bench [maxSize] [csv|json] [seed]
+//          (configure with -DCMAKE_BUILD_TYPE=Release for meaningful timings)
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using std::chrono::steady_clock;
+
+static const int MAX_LOOKUPS = 1000000;     // Lookups timed per size, so large sizes stay quick
+static const int REPEAT_BUDGET = 100000;    // Small sizes repeat until about this many inserts
+
+static long long checksum = 0;              // Printed at the end so no timed work is optimized away
+
+
+// ---------------------------------------------------------------------
+//                        Structure Adapters
+//
+// Each adapter wraps one structure in the same small interface. scan() and
+// breadthFirst() return false when the structure has no such traversal.
+
+struct RedBlackTreeAdapter {
+    static const char* name() { return "RedBlackTree"; }
+    RedBlackTree<float, int> tree;
+
+    void insert(float key, int value) { tree.insert(key, value); }
+    bool find(float key) { int* value = tree.findValue(key); checksum += value ? *value : 0; return value; }
+    void remove(float key) { tree.remove(key); }
+    bool scan() { tree.visitInOrder([](const float &, int & value) { checksum += value; }); return true; }
+    bool breadthFirst() { tree.visitBreadthFirst([](const float &, int & value) { checksum += value; }); return true; }
+};
+
+
+template <template <typename...> class Storage>
+struct CursedArrayAdapter {
+    static const char* name();
+    CursedArray<int, Storage> array;
+
+    void insert(float key, int value) { array[key] = value; }
+    bool find(float key) { int value = array[key]; checksum += value; return value != 0; }
+    void remove(float key) { array.remove(key); }
+    bool scan() { for (int value : array) checksum += value; return true; }
+    bool breadthFirst() { return false; }
+};
+
+template <>
+const char* CursedArrayAdapter<RedBlackTree>::name() { return "CursedArray<RedBlackTree>"; }
+template <>
+const char* CursedArrayAdapter<BPlusTree>::name() { return "CursedArray<BPlusTree>"; }
+
+
+struct MapAdapter {
+    static const char* name() { return "std::map"; }
+    std::map<float, int> map;
+
+    void insert(float key, int value) { map[key] = value; }
+    bool find(float key) { auto it = map.find(key); checksum += (it != map.end()) ? it->second : 0; return it != map.end(); }
+    void remove(float key) { map.erase(key); }
+    bool scan() { for (auto & pair : map) checksum += pair.second; return true; }
+    bool breadthFirst() { return false; }
+};
+
+
+struct UnorderedMapAdapter {
+    static const char* name() { return "std::unordered_map"; }
+    std::unordered_map<float, int> map;
+
+    void insert(float key, int value) { map[key] = value; }
+    bool find(float key) { auto it = map.find(key); checksum += (it != map.end()) ? it->second : 0; return it != map.end(); }
+    void remove(float key) { map.erase(key); }
+    bool scan() { for (auto & pair : map) checksum += pair.second; return true; }   // Unordered
+    bool breadthFirst() { return false; }
+};
+
+
+// ---------------------------------------------------------------------
+//                          Key Generation
+
+struct Workload {
+    std::vector<float> keys;        // Insertion order
+    std::vector<float> hitKeys;     // Present keys in random order
+    std::vector<float> missKeys;    // Absent keys from the same distribution
+    std::vector<float> removeKeys;  // Every distinct key in random order
+};
+
+
+/**
+ * Draws n keys from a distribution: "uniform" over [-1e6, 1e6), "sorted" (the same,
+ * inserted in ascending order), or "clustered" (16 tight normal clusters).
+ */
+std::vector<float> drawKeys(const std::string & distribution, int n, std::mt19937_64 & rng) {
+    std::vector<float> keys(n);
+
+    if (distribution == "clustered") {
+        std::uniform_real_distribution<float> centerDist(-1e6f, 1e6f);
+        std::vector<float> centers(16);
+        for (float & center : centers)
+            center = centerDist(rng);
+
+        std::normal_distribution<float> offset(0.f, 100.f);
+        for (float & key : keys)
+            key = centers[rng() % centers.size()] + offset(rng);
+    } else {
+        std::uniform_real_distribution<float> keyDist(-1e6f, 1e6f);
+        for (float & key : keys)
+            key = keyDist(rng);
+    }
+
+    if (distribution == "sorted")
+        std::sort(keys.begin(), keys.end());
+
+    return keys;
+}
+
+
+Workload makeWorkload(const std::string & distribution, int n, std::mt19937_64 & rng) {
+    Workload workload;
+    workload.keys = drawKeys(distribution, n, rng);
+
+    std::unordered_set<float> present(workload.keys.begin(), workload.keys.end());
+    workload.removeKeys.assign(present.begin(), present.end());
+    std::sort(workload.removeKeys.begin(), workload.removeKeys.end());
+    std::shuffle(workload.removeKeys.begin(), workload.removeKeys.end(), rng);
+
+    int lookups = std::min(n, MAX_LOOKUPS);
+    for (int i = 0; i < lookups; ++i)
+        workload.hitKeys.push_back(workload.keys[rng() % workload.keys.size()]);
+
+    while (int(workload.missKeys.size()) < lookups) {
+        for (float key : drawKeys(distribution == "sorted" ? "uniform" : distribution, lookups, rng)) {
+            if (!present.count(key) and int(workload.missKeys.size()) < lookups)
+                workload.missKeys.push_back(key);
+        }
+    }
+
+    return workload;
+}
+
+
+// ---------------------------------------------------------------------
+//                         Timing and Output
+
+struct Result {
+    const char* structure;
+    std::string distribution;
+    int size;
+    const char* operation;
+    double nsPerOp;
+    long long ops;
+};
+
+
+template <typename F>
+double timeNs(F body) {
+    auto begin = steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::nano>(steady_clock::now() - begin).count();
+}
+
+
+/**
+ * Runs every operation on one structure, keeping the best time of each over the repeats.
+ */
+template <typename Adapter>
+void benchStructure(const Workload & workload, const std::string & distribution, int repeats,
+                    std::vector<Result> & results) {
+    int n = int(workload.keys.size());
+    double best[6] = {1e300, 1e300, 1e300, 1e300, 1e300, 1e300};
+    bool hasBreadthFirst = true;
+
+    for (int repeat = 0; repeat < repeats; ++repeat) {
+        Adapter * adapter = new Adapter();
+
+        best[0] = std::min(best[0], timeNs([&]() {
+            for (int i = 0; i < n; ++i)
+                adapter->insert(workload.keys[i], i + 1);
+        }));
+        best[1] = std::min(best[1], timeNs([&]() {
+            for (float key : workload.hitKeys)
+                adapter->find(key);
+        }));
+        best[2] = std::min(best[2], timeNs([&]() {
+            for (float key : workload.missKeys)
+                adapter->find(key);
+        }));
+        best[3] = std::min(best[3], timeNs([&]() { adapter->scan(); }));
+        best[4] = std::min(best[4], timeNs([&]() { hasBreadthFirst = adapter->breadthFirst(); }));
+        best[5] = std::min(best[5], timeNs([&]() {
+            for (float key : workload.removeKeys)
+                adapter->remove(key);
+        }));
+
+        delete adapter;
+    }
+
+    const char* operations[6] = {"insert", "lookup_hit", "lookup_miss", "scan", "bfs", "remove"};
+    long long opCounts[6] = {n, (long long)workload.hitKeys.size(), (long long)workload.missKeys.size(),
+                             (long long)workload.removeKeys.size(), (long long)workload.removeKeys.size(),
+                             (long long)workload.removeKeys.size()};
+
+    for (int op = 0; op < 6; ++op) {
+        if (op == 4 and !hasBreadthFirst)
+            continue;
+        results.push_back({Adapter::name(), distribution, n, operations[op], best[op] / double(opCounts[op]), opCounts[op]});
+    }
+}
+
+
+void printResults(const std::vector<Result> & results, bool asJson) {
+    if (asJson) {
+        std::printf("[\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result & r = results[i];
+            std::printf("  {\"structure\": \"%s\", \"distribution\": \"%s\", \"size\": %d, "
+                        "\"operation\": \"%s\", \"ns_per_op\": %.2f, \"ops\": %lld}%s\n",
+                        r.structure, r.distribution.c_str(), r.size, r.operation, r.nsPerOp, r.ops,
+                        (i + 1 < results.size()) ? "," : "");
+        }
+        std::printf("]\n");
+    } else {
+        std::printf("structure,distribution,size,operation,ns_per_op,ops\n");
+        for (const Result & r : results)
+            std::printf("%s,%s,%d,%s,%.2f,%lld\n", r.structure, r.distribution.c_str(), r.size, r.operation, r.nsPerOp, r.ops);
+    }
+}
+
+
+int main(int argc, char* argv[]) {
+    long long maxSize = (argc > 1) ? std::atoll(argv[1]) : 1000000;
+    bool asJson = (argc > 2) and std::strcmp(argv[2], "json") == 0;
+    unsigned long long seed = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 42;
+
+    std::vector<Result> results;
+
+    for (const std::string distribution : {"uniform", "sorted", "clustered"}) {
+        for (long long size = 1000; size <= maxSize and size <= 100000000; size *= 10) {
+            std::mt19937_64 rng(seed + size);
+            Workload workload = makeWorkload(distribution, int(size), rng);
+            int repeats = std::max(1, int(REPEAT_BUDGET / size));
+
+            benchStructure<RedBlackTreeAdapter>(workload, distribution, repeats, results);
+            benchStructure<CursedArrayAdapter<RedBlackTree>>(workload, distribution, repeats, results);
+            benchStructure<CursedArrayAdapter<BPlusTree>>(workload, distribution, repeats, results);
+            benchStructure<MapAdapter>(workload, distribution, repeats, results);
+            benchStructure<UnorderedMapAdapter>(workload, distribution, repeats, results);
+            std::fprintf(stderr, "%s %lld done\n", distribution.c_str(), size);
+        }
+    }
+
+    printResults(results, asJson);
+    std::fprintf(stderr, "checksum %lld\n", checksum);
+    return 0;
+}
@@ -0,0 +1,140 @@
+//   File: mpmc_bench.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Producer/consumer handoff benchmark for MPMCQueue.
+//         Half the threads produce and half consume, comparing the lock-free
+//         queue (one value and batches of 16 per call) against Queue behind a
+//         mutex. Thread counts double from 2 up to maxThreads.
+//   Usage: mpmc_bench [maxThreads] [capacity] [millisecondsPerRun]
+// ---------------------------------------------------------------------
+
+#include "../MPMC_Queue.h"
+#include "../Queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::chrono::steady_clock;
+
+static const int BATCH_SIZE = 16;
+
+// Queue behind one mutex, bounded to the same capacity as the lock-free queue
+struct MutexQueue {
+    Queue<long> queue;
+    std::mutex mutex;
+    int capacity;
+
+    explicit MutexQueue(int capacity) : capacity{capacity} {}
+
+    int tryEnqueueBatch(const long* values, int count) {
+        std::lock_guard<std::mutex> guard(mutex);
+        int added = 0;
+        for (; added < count and queue.size() < capacity; ++added)
+            queue.enqueue(values[added]);
+        return added;
+    }
+
+    int tryDequeBatch(long* out, int maxCount) {
+        std::lock_guard<std::mutex> guard(mutex);
+        int taken = 0;
+        for (; taken < maxCount and !queue.isEmpty(); ++taken)
+            out[taken] = queue.deque();
+        return taken;
+    }
+};
+
+
+/**
+ * Runs producers and consumers against one queue for a fixed time.
+ * @param batch - Values moved per call (1 measures single-value handoff).
+ * @return Returns the values handed off per second.
+ */
+template <typename Q>
+double runHandoff(Q & queue, int threadCount, int batch, int milliseconds) {
+    int producers = threadCount / 2;
+    int consumers = threadCount - producers;
+
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::vector<long long> handoffCounts(consumers * 16, 0);    // Spaced out to avoid false sharing
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            long values[BATCH_SIZE];
+            long next = long(p) << 40;
+
+            while (!start.load())
+                std::this_thread::yield();
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < batch; ++i)
+                    values[i] = next + i;
+                next += queue.tryEnqueueBatch(values, batch);
+            }
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            long values[BATCH_SIZE];
+            long long handoffs = 0;
+            long checksum = 0;
+
+            while (!start.load())
+                std::this_thread::yield();
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                int taken = queue.tryDequeBatch(values, batch);
+                for (int i = 0; i < taken; ++i)
+                    checksum += values[i];
+                handoffs += taken;
+            }
+
+            handoffCounts[c * 16] = handoffs + (checksum == -1);
+        });
+    }
+
+    auto begin = steady_clock::now();
+    start.store(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop.store(true);
+    for (std::thread & thread : threads)
+        thread.join();
+    double seconds = std::chrono::duration<double>(steady_clock::now() - begin).count();
+
+    long long totalHandoffs = 0;
+    for (int c = 0; c < consumers; ++c)
+        totalHandoffs += handoffCounts[c * 16];
+
+    return double(totalHandoffs) / seconds;
+}
+
+
+int main(int argc, char* argv[]) {
+    int maxThreads = (argc > 1) ? std::atoi(argv[1]) : 64;
+    int capacity = (argc > 2) ? std::atoi(argv[2]) : 4096;
+    int milliseconds = (argc > 3) ? std::atoi(argv[3]) : 300;
+
+    std::printf("queue,threads,batch,mops_per_sec\n");
+
+    for (int threads = 2; threads <= maxThreads; threads *= 2) {
+        for (int batch : {1, BATCH_SIZE}) {
+            MPMCQueue<long> lockFree(capacity);
+            std::printf("MPMCQueue,%d,%d,%.3f\n", threads, batch,
+                        runHandoff(lockFree, threads, batch, milliseconds) / 1e6);
+
+            MutexQueue locked(capacity);
+            std::printf("mutex+Queue,%d,%d,%.3f\n", threads, batch,
+                        runHandoff(locked, threads, batch, milliseconds) / 1e6);
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
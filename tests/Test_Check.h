@@ -0,0 +1,38 @@
+//   File: Test_Check.h
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Minimal checks shared by the test executables.
+//         A failed CHECK prints its location and expression and the test keeps
+//         going; main() returns testResult() so ctest sees any failure.
+// ---------------------------------------------------------------------
+
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <cstdio>
+
+inline int & testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                     \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++testFailures();                                                                \
+        }                                                                                    \
+    } while (false)
+
+/**
+ * @return Returns 0 if every check passed, 1 otherwise.
+ */
+inline int testResult() {
+    if (testFailures() > 0)
+        std::fprintf(stderr, "%d check(s) failed\n", testFailures());
+
+    return testFailures() > 0 ? 1 : 0;
+}
+
+
+#endif //TEST_CHECK_H
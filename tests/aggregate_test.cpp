@@ -0,0 +1,102 @@
+//   File: aggregate_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: RangeAggregate sums, minimums, maximums and counts against a brute-force fold.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+
+template <typename K, typename V>
+using SumTree = RedBlackTree<K, V, RangeAggregate<SumMonoid<long>>>;
+template <typename K, typename V>
+using MinTree = RedBlackTree<K, V, RangeAggregate<MinMonoid<int>>>;
+template <typename K, typename V>
+using MaxTree = RedBlackTree<K, V, RangeAggregate<MaxMonoid<int>>>;
+template <typename K, typename V>
+using CountTree = RedBlackTree<K, V, RangeAggregate<CountMonoid>>;
+
+
+void testTreesAgainstBruteForce() {
+    std::mt19937 random(9);
+    SumTree<int, int> sums;
+    MinTree<int, int> minimums;
+    MaxTree<int, int> maximums;
+    CountTree<int, int> counts;
+    std::map<int, int> expected;
+
+    for (int step = 0; step < 20000; ++step) {
+        int key = int(random() % 1000);
+        int value = int(random() % 2001) - 1000;
+
+        if (random() % 4 != 0) {
+            sums.insert(key, value);
+            minimums.insert(key, value);
+            maximums.insert(key, value);
+            counts.insert(key, value);
+            expected[key] = value;
+        } else {
+            sums.remove(key);
+            minimums.remove(key);
+            maximums.remove(key);
+            counts.remove(key);
+            expected.erase(key);
+        }
+
+        if (step % 500 != 0)
+            continue;
+
+        for (int query = 0; query < 20; ++query) {
+            int low = int(random() % 1100) - 50;
+            int high = low + int(random() % 300);
+
+            long sum = 0;
+            int minimum = std::numeric_limits<int>::max();
+            int maximum = std::numeric_limits<int>::lowest();
+            int count = 0;
+            for (auto it = expected.lower_bound(low); it != expected.end() and it->first <= high; ++it) {
+                sum += it->second;
+                minimum = std::min(minimum, it->second);
+                maximum = std::max(maximum, it->second);
+                ++count;
+            }
+
+            CHECK(sums.aggregate(low, high) == sum);
+            CHECK(minimums.aggregate(low, high) == minimum);
+            CHECK(maximums.aggregate(low, high) == maximum);
+            CHECK(counts.aggregate(low, high) == count);
+        }
+    }
+
+    CHECK(sums.aggregate(10, 5) == 0);      // Empty window gives the identity
+}
+
+
+void testCursedArrayAggregate() {
+    CursedArray<int, SumTree> array;
+    for (int i = 1; i <= 100; ++i)
+        array[float(i)] = i;
+
+    CHECK(array.aggregate(1.f, 100.f) == 5050);
+    CHECK(array.aggregate(10.5f, 20.f) == 155);
+
+    array[15.f] = 0;    // Overwrites refresh the cached sums
+    CHECK(array.aggregate(10.5f, 20.f) == 140);
+
+    array.freeze();
+    CHECK(array.aggregate(10.5f, 20.f) == 140);
+    CHECK(array.aggregate(200.f, 300.f) == 0);
+    CHECK(array.aggregate(20.f, 10.f) == 0);    // Inverted bounds are an empty window too
+}
+
+
+int main() {
+    testTreesAgainstBruteForce();
+    testCursedArrayAggregate();
+    return testResult();
+}
@@ -0,0 +1,119 @@
+//   File: bplus_tree_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: BPlusTree against std::map, and as CursedArray storage.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <map>
+#include <random>
+#include <string>
+
+/**
+ * Walks the tree both ways and compares it with the reference.
+ */
+void checkMatches(BPlusTree<int, long> & tree, const std::map<int, long> & expected) {
+    CHECK(tree.size() == int(expected.size()));
+
+    auto want = expected.begin();
+    for (auto it = tree.begin(); it != tree.end() and want != expected.end(); ++it, ++want)
+        CHECK(it.key() == want->first and *it == want->second);
+
+    auto wantBack = expected.rbegin();
+    for (auto it = tree.end(); wantBack != expected.rend(); ++wantBack) {
+        --it;
+        CHECK(it.key() == wantBack->first and *it == wantBack->second);
+    }
+}
+
+
+void testRandomOperations() {
+    std::mt19937 random(12);
+    BPlusTree<int, long> tree;
+    std::map<int, long> expected;
+
+    // Enough keys for several levels, with removes heavy enough to force merges
+    for (int step = 0; step < 60000; ++step) {
+        int key = int(random() % 5000);
+        int action = int(random() % 10);
+
+        if (action < 5) {
+            tree.insert(key, step);
+            expected[key] = step;
+        } else if (action < 9) {
+            CHECK(tree.remove(key) == (expected.erase(key) == 1));
+        } else {
+            long* value = tree.findValue(key);
+            auto found = expected.find(key);
+            CHECK((value != nullptr) == (found != expected.end()));
+            CHECK(!value or *value == found->second);
+        }
+    }
+    checkMatches(tree, expected);
+
+    for (int key = 0; key < 5000; ++key) {
+        auto bound = tree.lower_bound(key);
+        auto want = expected.lower_bound(key);
+        CHECK((bound == tree.end()) == (want == expected.end()));
+        CHECK(bound == tree.end() or bound.key() == want->first);
+    }
+
+    for (int key = 0; key < 5000; ++key)
+        tree.remove(key);
+    CHECK(tree.size() == 0 and tree.begin() == tree.end());
+}
+
+
+void testBulkLoad() {
+    std::vector<int> keys;
+    std::vector<long> values;
+    for (int i = 0; i < 10000; ++i) {
+        keys.push_back(3 * i);
+        values.push_back(i);
+    }
+
+    BPlusTree<int, long> tree;
+    tree.assignSorted(keys.begin(), keys.end(), values.begin());
+
+    std::map<int, long> expected;
+    for (int i = 0; i < 10000; ++i)
+        expected[3 * i] = i;
+    checkMatches(tree, expected);
+
+    tree.insert(1, -1);
+    expected[1] = -1;
+    checkMatches(tree, expected);
+}
+
+
+void testCursedArrayStorage() {
+    CursedArray<std::string, BPlusTree> array;
+
+    for (int i = 0; i < 2000; ++i)
+        array[float(i) / 4] = std::to_string(i);
+    CHECK(array.size() == 2000);
+    CHECK(std::string(array[12.5f]) == "50");
+    CHECK(std::string(array[0.3f]).empty());
+
+    CHECK(array.remove(12.5f));
+    CHECK(!array.remove(12.5f));
+    CHECK(array.size() == 1999);
+
+    float previous = -1.f;
+    int visited = 0;
+    for (auto it = array.begin(); it != array.end(); ++it, ++visited) {
+        CHECK(previous < it.key());
+        previous = it.key();
+    }
+    CHECK(visited == 1999);
+}
+
+
+int main() {
+    testRandomOperations();
+    testBulkLoad();
+    testCursedArrayStorage();
+    return testResult();
+}
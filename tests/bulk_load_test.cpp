@@ -0,0 +1,97 @@
+//   File: bulk_load_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: assignSorted() and assign() on RedBlackTree and CursedArray.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+void testAssignSortedAtEverySize() {
+    for (int size = 0; size <= 70; ++size) {
+        std::vector<int> keys;
+        std::vector<std::string> values;
+        for (int i = 0; i < size; ++i) {
+            keys.push_back(i * 10);
+            values.push_back(std::to_string(i));
+        }
+
+        RedBlackTree<int, std::string> tree;
+        tree.insert(-5, "replaced");
+        tree.assignSorted(keys.begin(), keys.end(), values.begin());
+        CHECK(tree.size() == size);
+        CHECK(tree.findValue(-5) == nullptr);
+
+        int expected = 0;
+        tree.visitInOrder([&](int key, const std::string & value) {
+            CHECK(key == expected * 10 and value == std::to_string(expected));
+            ++expected;
+        });
+        CHECK(expected == size);
+
+        // The built tree must take ordinary inserts and removes afterwards
+        for (int i = 0; i < size; i += 2)
+            CHECK(tree.remove(i * 10));
+        for (int i = 0; i < size; ++i)
+            tree.insert(i * 10 + 5, "odd");
+        CHECK(tree.size() == size - (size + 1) / 2 + size);
+    }
+}
+
+
+void testAssignKeepsLastDuplicate() {
+    std::mt19937 random(4);
+    std::vector<int> keys;
+    std::vector<int> values;
+    std::map<int, int> expected;
+
+    for (int i = 0; i < 5000; ++i) {
+        int key = int(random() % 1000) - 500;
+        keys.push_back(key);
+        values.push_back(i);
+        expected[key] = i;      // Later pairs win, as if inserted in turn
+    }
+
+    RedBlackTree<int, int> tree;
+    tree.assign(keys.begin(), keys.end(), values.begin());
+    CHECK(tree.size() == int(expected.size()));
+
+    auto want = expected.begin();
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++want)
+        CHECK(it.key() == want->first and *it == want->second);
+}
+
+
+void testCursedArrayAssign() {
+    std::vector<float> keys = {3.5f, -1.f, 2.f, 3.5f, 0.f, -0.f};
+    std::vector<int> values = {1, 2, 3, 4, 5, 6};
+
+    CursedArray<int> array;
+    array[100.f] = 7;
+    array.assign(keys.begin(), keys.end(), values.begin());
+
+    CHECK(array.size() == 4);
+    CHECK(int(array[100.f]) == 0);
+    CHECK(int(array[3.5f]) == 4);
+    CHECK(int(array[0.f]) == 6);    // -0.0 names the same index as +0.0
+    CHECK(array.begin().key() == -1.f);
+
+    std::vector<float> sortedKeys = {-2.f, 1.f, 4.f};
+    std::vector<int> sortedValues = {8, 9, 10};
+    array.assignSorted(sortedKeys.begin(), sortedKeys.end(), sortedValues.begin());
+    CHECK(array.size() == 3);
+    CHECK(int(array[4.f]) == 10 and int(array[3.5f]) == 0);
+}
+
+
+int main() {
+    testAssignSortedAtEverySize();
+    testAssignKeepsLastDuplicate();
+    testCursedArrayAssign();
+    return testResult();
+}
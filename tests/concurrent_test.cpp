@@ -0,0 +1,148 @@
+//   File: concurrent_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: ConcurrentCursedArray under parallel readers and writers.
+//         Also worth running under ThreadSanitizer.
+// ---------------------------------------------------------------------
+
+#include "../Concurrent_CursedArray.h"
+#include "Test_Check.h"
+
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+const int THREADS = 4;
+const int KEYS_PER_THREAD = 2000;
+
+/**
+ * Writers fill disjoint ranges while readers poll; every write must land exactly once.
+ */
+template <typename Lock>
+void testParallelWriters() {
+    ConcurrentCursedArray<int, RedBlackTree, Lock> array;
+    std::atomic<bool> writing{true};
+    std::atomic<int> badReads{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < KEYS_PER_THREAD; ++i)
+                array[float(t * KEYS_PER_THREAD + i)] = t * KEYS_PER_THREAD + i + 1;
+        });
+    }
+    std::thread reader([&]() {
+        while (writing.load()) {
+            for (int key = 0; key < THREADS * KEYS_PER_THREAD; key += 97) {
+                int value = array.get(float(key));
+                if (value != 0 and value != key + 1)
+                    badReads.fetch_add(1);
+            }
+        }
+    });
+
+    for (std::thread & thread : threads)
+        thread.join();
+    writing.store(false);
+    reader.join();
+
+    CHECK(badReads.load() == 0);
+    CHECK(array.read([](auto & contents) { return contents.size(); }) == THREADS * KEYS_PER_THREAD);
+    for (int key = 0; key < THREADS * KEYS_PER_THREAD; ++key)
+        CHECK(array.get(float(key)) == key + 1);
+}
+
+
+/**
+ * A write() batch is seen by readers all at once: the two keys always match.
+ */
+void testBatchesAreAtomic() {
+    ConcurrentCursedArray<int> array;
+    array.write([](auto & contents) { contents[0.f] = 0; contents[1.f] = 0; return 0; });
+
+    std::atomic<int> torn{0};
+    std::thread writer([&]() {
+        for (int i = 1; i <= 20000; ++i)
+            array.write([i](auto & contents) { contents[0.f] = i; contents[1.f] = i; return 0; });
+    });
+    std::thread reader([&]() {
+        for (int i = 0; i < 20000; ++i) {
+            bool same = array.read([](auto & contents) { return int(contents[0.f]) == int(contents[1.f]); });
+            if (!same)
+                torn.fetch_add(1);
+        }
+    });
+
+    writer.join();
+    reader.join();
+    CHECK(torn.load() == 0);
+    CHECK(array.get(1.f) == 20000);
+}
+
+
+/**
+ * Reads of LazyAddTree storage push tags down, so they take the lock exclusively.
+ */
+void testLazyStorageReads() {
+    ConcurrentCursedArray<int, LazyAddTree> array;
+    for (int i = 0; i < 1000; ++i)
+        array[float(i)] = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 200; ++i) {
+                if (t == 0)
+                    array.write([](auto & contents) { contents.addToAll(1); return 0; });
+                else
+                    (void) array.get(float(i * 5));
+            }
+        });
+    }
+    for (std::thread & thread : threads)
+        thread.join();
+
+    for (int i = 0; i < 1000; ++i)
+        CHECK(array.get(float(i)) == 200);
+}
+
+
+/**
+ * Non-float keys are forwarded to the underlying CursedArray.
+ */
+void testOtherKeyTypes() {
+    ConcurrentCursedArray<int, RedBlackTree, ReadMostlyLock, int> intArray;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < KEYS_PER_THREAD; ++i)
+                intArray.set(-(t * KEYS_PER_THREAD + i), i);
+        });
+    }
+    for (std::thread & thread : threads)
+        thread.join();
+
+    CHECK(intArray.read([](auto & contents) { return contents.size(); }) == THREADS * KEYS_PER_THREAD);
+    CHECK(intArray.get(-(3 * KEYS_PER_THREAD + 7)) == 7);
+    // Beyond float's 24-bit mantissa; a float key would merge these
+    intArray[16777217] = 1;
+    intArray[16777216] = 2;
+    CHECK(int(intArray[16777217]) == 1);
+
+    ConcurrentCursedArray<int, RedBlackTree, std::shared_mutex, double> doubleArray;
+    doubleArray[0.1] = 1;
+    doubleArray[0.1 + 1e-12] = 2;
+    CHECK(doubleArray.get(0.1) == 1);
+    CHECK(doubleArray.get(0.1 + 1e-12) == 2);
+}
+
+
+int main() {
+    testParallelWriters<ReadMostlyLock>();
+    testParallelWriters<std::shared_mutex>();
+    testBatchesAreAtomic();
+    testLazyStorageReads();
+    testOtherKeyTypes();
+    return testResult();
+}
@@ -0,0 +1,263 @@
+//   File: durable_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: CursedJournal replay and DurableCursedArray recovery and compaction.
+// ---------------------------------------------------------------------
+
+#include "../Durable_CursedArray.h"
+#include "Test_Check.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace fs = std::filesystem;
+
+/**
+ * @return Returns a fresh, empty scratch directory.
+ */
+std::string scratchDirectory() {
+    char pattern[] = "/tmp/cursed_durable_test_XXXXXX";
+    return ::mkdtemp(pattern);
+}
+
+
+/**
+ * @return Returns the number of files in a directory.
+ */
+int fileCount(const std::string & directory) {
+    int count = 0;
+    for (const fs::directory_entry & entry : fs::directory_iterator(directory))
+        count += entry.is_regular_file();
+    return count;
+}
+
+
+/**
+ * Committed records replay in order; a torn tail batch is skipped.
+ */
+void testJournalReplay() {
+    std::string directory = scratchDirectory();
+    std::string path = directory + "/j.journal";
+    JournalOptions options;
+    options.fsyncPolicy = FsyncPolicy::NEVER;
+
+    {
+        CursedJournal<long> journal;
+        CHECK(journal.create(path, options));
+        CHECK(journal.appendSet(1.f, 10));
+        CHECK(journal.appendSet(2.f, 20));
+        CHECK(journal.commit());
+        CHECK(journal.appendRemove(1.f));
+        CHECK(journal.commit());
+        CHECK(journal.appendSet(3.f, 30));      // Committed by close()
+
+        CursedJournal<long> duplicate;
+        CHECK(!duplicate.create(path, options));
+    }
+
+    std::vector<std::string> records;
+    auto record = [&](uint8_t op, float index, const long* value) {
+        records.push_back(std::to_string(int(op)) + ":" + std::to_string(int(index))
+                          + ":" + (value ? std::to_string(*value) : "-"));
+    };
+    CHECK(CursedJournal<long>::replay(path, record));
+    CHECK((records == std::vector<std::string>{"1:1:10", "1:2:20", "2:1:-", "1:3:30"}));
+
+    // Chop the last batch in half, as a crash mid-write would
+    fs::resize_file(path, fs::file_size(path) - 5);
+    records.clear();
+    CHECK(CursedJournal<long>::replay(path, record));
+    CHECK(records.size() == 3);
+
+    CHECK(!CursedJournal<int>::replay(path, [](uint8_t, float, const int*) {}));     // Wrong value size
+    CHECK(!CursedJournal<long>::replay(directory + "/missing", record));
+    fs::remove_all(directory);
+}
+
+
+/**
+ * A batch cut short by a failed write is trimmed off, so the retried batch replays.
+ */
+void testFailedCommitIsTrimmed() {
+    std::string directory = scratchDirectory();
+    std::string path = directory + "/j.journal";
+    JournalOptions options;
+    options.fsyncPolicy = FsyncPolicy::NEVER;
+    options.groupCommitBytes = 1 << 20;
+
+    CursedJournal<long> journal;
+    CHECK(journal.create(path, options));
+    CHECK(journal.appendSet(1.f, 1));
+    CHECK(journal.commit());
+    uint64_t committedBytes = fs::file_size(path);
+
+    // Cap the file size so the next batch is written only in part
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit oldLimit;
+    ::getrlimit(RLIMIT_FSIZE, &oldLimit);
+    rlimit smallLimit = oldLimit;
+    smallLimit.rlim_cur = rlim_t(committedBytes + 100);
+    CHECK(::setrlimit(RLIMIT_FSIZE, &smallLimit) == 0);
+
+    for (int i = 2; i < 100; ++i)
+        journal.appendSet(float(i), i);
+    CHECK(!journal.commit());
+    CHECK(fs::file_size(path) == committedBytes);
+
+    CHECK(::setrlimit(RLIMIT_FSIZE, &oldLimit) == 0);
+    CHECK(journal.commit());
+    journal.close();
+
+    int records = 0;
+    CHECK(CursedJournal<long>::replay(path, [&](uint8_t, float index, const long* value) {
+        CHECK(value and *value == long(index));
+        ++records;
+    }));
+    CHECK(records == 99);
+    fs::remove_all(directory);
+}
+
+
+/**
+ * Writes survive close and reopen, replayed over the latest snapshot.
+ */
+void testRecovery() {
+    std::string directory = scratchDirectory();
+    std::string prefix = directory + "/array";
+
+    {
+        DurableCursedArray<int> array;
+        CHECK(array.open(prefix));
+        for (int i = 0; i < 1000; ++i)
+            CHECK(array.set(float(i), i));
+        for (int i = 0; i < 1000; i += 2)
+            CHECK(array.remove(float(i)));
+        CHECK(!array.remove(0.f));
+        array[1.f] = 100;
+        CHECK(array.commit());
+    }
+
+    {
+        DurableCursedArray<int> array;
+        CHECK(array.open(prefix));
+        CHECK(array.size() == 500);
+        CHECK(array.get(1.f) == 100);
+        CHECK(array.get(2.f) == 0);
+        CHECK(array.get(999.f) == 999);
+
+        // Each open starts a new journal; the old ones still replay
+        array[2.f] = 2;
+    }
+
+    DurableCursedArray<int> array;
+    CHECK(array.open(prefix));
+    CHECK(array.size() == 501);
+    CHECK(array.get(2.f) == 2);
+
+    array.close();
+    CHECK(!array.isOpen());
+    CHECK(!array.set(5.f, 5));
+    CHECK(array.size() == 501);     // The contents are kept after close()
+    fs::remove_all(directory);
+}
+
+
+/**
+ * NaN and -0.0 indexes replay and merge by their encodings, so no other index is lost.
+ */
+void testRecoveryWithSpecialIndexes() {
+    std::string directory = scratchDirectory();
+    std::string prefix = directory + "/array";
+    const float notANumber = std::numeric_limits<float>::quiet_NaN();
+
+    {
+        DurableCursedArray<int> array;
+        CHECK(array.open(prefix));
+        array.set(3.f, 30);
+        array.set(notANumber, 99);
+        array.set(1.f, 10);
+        array.set(2.f, 20);
+        array.set(notANumber, 100);
+        array.set(0.5f, 5);
+        array.set(-0.f, 0);
+    }
+    {
+        DurableCursedArray<int> array;
+        CHECK(array.open(prefix));
+        CHECK(array.size() == 6);
+        CHECK(array.get(3.f) == 30 and array.get(notANumber) == 100 and array.get(0.f) == 0);
+
+        // Now merge journal records over a snapshot holding NaN
+        CHECK(array.compact());
+        array.waitForCompaction();
+        array.set(notANumber, 101);
+        array.set(0.f, -5);
+        array.remove(1.f);
+    }
+
+    DurableCursedArray<int> array;
+    CHECK(array.open(prefix));
+    CHECK(array.size() == 5);
+    CHECK(array.get(notANumber) == 101 and array.get(-0.f) == -5);
+    CHECK(array.get(2.f) == 20 and array.get(1.f) == 0);
+    fs::remove_all(directory);
+}
+
+
+/**
+ * Compaction snapshots the contents, deletes older files, and loses nothing.
+ */
+void testCompaction() {
+    std::string directory = scratchDirectory();
+    std::string prefix = directory + "/array";
+    JournalOptions options;
+    options.fsyncPolicy = FsyncPolicy::NEVER;
+    options.groupCommitBytes = 1024;
+    options.compactionBytes = 16 * 1024;
+
+    {
+        DurableCursedArray<double> array;
+        CHECK(array.open(prefix, options));
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < 2000; ++i)
+                array.set(float(i), round * 10000.0 + i);
+        }
+        array.remove(7.f);
+        array.waitForCompaction();
+        CHECK(array.commit());
+        array.waitForCompaction();
+    }
+    // At most one snapshot and its journals remain
+    CHECK(fileCount(directory) <= 3);
+
+    DurableCursedArray<double> array;
+    CHECK(array.open(prefix, options));
+    CHECK(array.size() == 1999);
+    CHECK(array.get(7.f) == 0.0);
+    CHECK(array.get(1234.f) == 41234.0);
+
+    // An explicit compaction, then recovery from the snapshot alone
+    CHECK(array.compact());
+    array.close();
+    DurableCursedArray<double> reopened;
+    CHECK(reopened.open(prefix, options));
+    CHECK(reopened.size() == 1999);
+    CHECK(reopened.get(1999.f) == 41999.0);
+    fs::remove_all(directory);
+}
+
+
+int main() {
+    testJournalReplay();
+    testFailedCommitIsTrimmed();
+    testRecovery();
+    testRecoveryWithSpecialIndexes();
+    testCompaction();
+    return testResult();
+}
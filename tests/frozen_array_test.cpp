@@ -0,0 +1,93 @@
+//   File: frozen_array_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: FrozenArray searches at every size, and CursedArray freeze()/thaw().
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Every size up to a few full levels, so each shape of incomplete bottom level is searched.
+ */
+void testSearchesAtEverySize() {
+    for (int size = 0; size <= 140; ++size) {
+        std::vector<int> keys;
+        std::vector<int> values;
+        for (int i = 0; i < size; ++i) {
+            keys.push_back(2 * i);      // Odd keys fall between stored ones
+            values.push_back(10 * i);
+        }
+
+        FrozenArray<int, int> frozen;
+        frozen.assign(keys, values);
+        CHECK(frozen.size() == size);
+
+        for (int key = -1; key <= 2 * size; ++key) {
+            int* value = frozen.findValue(key);
+            bool stored = key >= 0 and key % 2 == 0 and key < 2 * size;
+            CHECK((value != nullptr) == stored);
+            CHECK(!value or *value == 5 * key);
+
+            auto lower = frozen.lower_bound(key);
+            int expectedLower = (key < 0) ? 0 : (key + 1) / 2 * 2;
+            CHECK((lower == frozen.end()) == (expectedLower >= 2 * size));
+            CHECK(lower == frozen.end() or lower.key() == expectedLower);
+
+            auto upper = frozen.upper_bound(key);
+            int expectedUpper = (key < 0) ? 0 : key / 2 * 2 + 2;
+            CHECK((upper == frozen.end()) == (expectedUpper >= 2 * size));
+            CHECK(upper == frozen.end() or upper.key() == expectedUpper);
+        }
+
+        // In-order walk both ways
+        int expectedKey = 0;
+        for (auto it = frozen.begin(); it != frozen.end(); ++it, expectedKey += 2)
+            CHECK(it.key() == expectedKey);
+        CHECK(expectedKey == 2 * size);
+
+        for (auto it = frozen.end(); expectedKey > 0; ) {
+            --it;
+            expectedKey -= 2;
+            CHECK(it.key() == expectedKey);
+        }
+    }
+}
+
+
+void testFreezeAndThaw() {
+    CursedArray<std::string> array;
+    for (int i = 0; i < 1000; ++i)
+        array[float(i) * 0.5f] = "v" + std::to_string(i);
+
+    array.freeze();
+    CHECK(array.isFrozen());
+    CHECK(array.size() == 1000);
+    CHECK(std::string(array[10.f]) == "v20");
+    CHECK(std::string(array[10.25f]).empty());
+    CHECK(array.lower_bound(10.25f).key() == 10.5f);
+
+    // Writing thaws the array and keeps everything
+    array[10.25f] = "new";
+    CHECK(!array.isFrozen());
+    CHECK(array.size() == 1001);
+    CHECK(std::string(array[10.25f]) == "new");
+    CHECK(std::string(array[499.5f]) == "v999");
+
+    array.freeze();
+    CHECK(array.remove(10.25f));
+    CHECK(array.size() == 1000);
+    array.thaw();
+    CHECK(!array.isFrozen());
+    CHECK(std::string(array[0.f]) == "v0");
+}
+
+
+int main() {
+    testSearchesAtEverySize();
+    testFreezeAndThaw();
+    return testResult();
+}
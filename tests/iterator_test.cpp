@@ -0,0 +1,78 @@
+//   File: iterator_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: CursedArray iterators and lower_bound/upper_bound/equal_range,
+//         over each storage and while frozen.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <iterator>
+#include <map>
+#include <random>
+
+template <typename Array>
+void checkBounds(Array & array, const std::map<float, int> & expected) {
+    for (float index = -2.f; index <= 52.f; index += 0.25f) {
+        auto lower = array.lower_bound(index);
+        auto wantLower = expected.lower_bound(index);
+        CHECK((lower == array.end()) == (wantLower == expected.end()));
+        CHECK(lower == array.end() or (lower.key() == wantLower->first and *lower == wantLower->second));
+
+        auto upper = array.upper_bound(index);
+        auto wantUpper = expected.upper_bound(index);
+        CHECK((upper == array.end()) == (wantUpper == expected.end()));
+        CHECK(upper == array.end() or upper.key() == wantUpper->first);
+
+        auto range = array.equal_range(index);
+        CHECK(std::distance(range.first, range.second) == long(expected.count(index)));
+    }
+}
+
+
+template <template <typename...> class Storage>
+void testStorage() {
+    std::mt19937 random(6);
+    CursedArray<int, Storage> array;
+    std::map<float, int> expected;
+
+    for (int i = 0; i < 150; ++i) {
+        float index = float(random() % 200) / 4.f;
+        array[index] = i;
+        expected[index] = i;
+    }
+
+    // Forward and backward walks
+    auto want = expected.begin();
+    for (auto it = array.begin(); it != array.end(); ++it, ++want)
+        CHECK(it.key() == want->first and *it == want->second);
+    CHECK(want == expected.end());
+
+    auto wantBack = expected.rbegin();
+    for (auto it = array.end(); it != array.begin(); ++wantBack) {
+        --it;
+        CHECK(it.key() == wantBack->first);
+    }
+    CHECK(wantBack == expected.rend());
+
+    // Values can be updated through an iterator
+    *array.begin() = -1;
+    expected.begin()->second = -1;
+
+    checkBounds(array, expected);
+    array.freeze();
+    checkBounds(array, expected);
+    array.thaw();
+
+    CursedArray<int, Storage> empty;
+    CHECK(empty.begin() == empty.end());
+    CHECK(empty.lower_bound(0.f) == empty.end());
+}
+
+
+int main() {
+    testStorage<RedBlackTree>();
+    testStorage<BPlusTree>();
+    return testResult();
+}
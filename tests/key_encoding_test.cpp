@@ -0,0 +1,160 @@
+//   File: key_encoding_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Order-preserving integer encodings of float and double indexes.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+const float INF = std::numeric_limits<float>::infinity();
+
+/**
+ * Unsigned order of the encodings matches numeric order, and decoding round-trips.
+ */
+void testEncodingOrder() {
+    using Traits = KeyTraits<float>;
+    std::vector<float> ascending = {-INF, -1e30f, -1.f, -1e-40f, 0.f, 1e-40f, 1.f, 1e30f, INF};
+
+    for (size_t i = 0; i + 1 < ascending.size(); ++i)
+        CHECK(Traits::encode(ascending[i]) < Traits::encode(ascending[i + 1]));
+    for (float key : ascending)
+        CHECK(Traits::decode(Traits::encode(key)) == key);
+
+    // -0.0 folds into +0.0; every NaN folds into one that sorts last
+    CHECK(Traits::encode(-0.f) == Traits::encode(0.f));
+    CHECK(Traits::encode(NOT_A_NUMBER) == Traits::encode(-NOT_A_NUMBER));
+    CHECK(Traits::encode(INF) < Traits::encode(NOT_A_NUMBER));
+    CHECK(std::isnan(Traits::decode(Traits::encode(NOT_A_NUMBER))));
+
+    using DoubleTraits = KeyTraits<double>;
+    CHECK(DoubleTraits::encode(-2.0) < DoubleTraits::encode(-1.0));
+    CHECK(DoubleTraits::encode(1.0) < DoubleTraits::encode(1.0 + 1e-15));
+    CHECK(DoubleTraits::decode(DoubleTraits::encode(-3.5)) == -3.5);
+}
+
+
+/**
+ * A CursedArray orders random indexes like std::map, with NaN as one extra, last index.
+ */
+void testArrayOrder() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> distribution(-100.f, 100.f);
+
+    for (bool frozen : {false, true}) {
+        CursedArray<int> array;
+        std::map<float, int> model;
+        for (int i = 0; i < 5000; ++i) {
+            float key = std::round(distribution(rng) * 10.f) / 10.f;
+            array[key] = i;
+            model[key] = i;
+        }
+
+        array[-0.f] = 77;
+        model[0.f] = 77;
+        CHECK(array[0.f] == 77);
+
+        array[NOT_A_NUMBER] = 5;
+        array[-NOT_A_NUMBER] = 6;
+        CHECK(array[NOT_A_NUMBER] == 6);
+        CHECK(array.size() == int(model.size()) + 1);
+        CHECK(std::isnan(std::prev(array.end()).key()));
+        CHECK(array.remove(NOT_A_NUMBER));
+
+        if (frozen)
+            array.freeze();
+
+        auto it = array.begin();
+        for (const auto & pair : model) {
+            CHECK(it.key() == pair.first and *it == pair.second);
+            ++it;
+        }
+        CHECK(it == array.end());
+    }
+}
+
+
+/**
+ * assign() sorts by encoding, and the last value for a repeated index wins.
+ */
+void testAssign() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> distribution(-1000.f, 1000.f);
+    std::vector<float> keys;
+    std::vector<int> values;
+    std::map<float, int> model;
+
+    for (int i = 0; i < 10000; ++i) {
+        float key = std::round(distribution(rng));
+        keys.push_back(key);
+        values.push_back(i);
+        model[key] = i;
+    }
+    keys.push_back(-0.f);
+    values.push_back(-1);
+    model[0.f] = -1;
+
+    CursedArray<int> array;
+    array.assign(keys.begin(), keys.end(), values.begin());
+    CHECK(array.size() == int(model.size()));
+    for (const auto & pair : model)
+        CHECK(array[pair.first] == pair.second);
+
+    auto it = array.begin();
+    for (const auto & pair : model) {
+        CHECK(it.key() == pair.first);
+        ++it;
+    }
+}
+
+
+/**
+ * A snapshot holding a NaN index loads back, since load() checks order by encoding.
+ */
+void testSnapshotWithNaN() {
+    std::string path = "/tmp/cursed_key_encoding_test_" + std::to_string(::getpid());
+    CursedArray<int> array;
+    array[1.f] = 10;
+    array[NOT_A_NUMBER] = 99;
+    array[-1.f] = -10;
+    CHECK(array.save(path));
+
+    CursedArray<int> loaded;
+    CHECK(loaded.load(path));
+    CHECK(loaded.size() == 3);
+    CHECK(loaded[NOT_A_NUMBER] == 99 and loaded[-1.f] == -10);
+
+    MappedCursedArray<int> view;
+    CHECK(view.open(path));
+    CHECK(view.findValue(NOT_A_NUMBER) and *view.findValue(NOT_A_NUMBER) == 99);
+    CHECK(view[1.f] == 10 and view[-1.f] == -10);
+    CHECK(view.findValue(2.f) == nullptr);
+
+    // Without a NaN saved, looking one up finds nothing
+    CursedArray<int> numbers;
+    numbers[1.f] = 10;
+    numbers[2.f] = 20;
+    numbers[0.f] = 0;
+    CHECK(numbers.save(path));
+    CHECK(view.open(path));
+    CHECK(view.findValue(NOT_A_NUMBER) == nullptr);
+    CHECK(view[-0.f] == 0 and view[2.f] == 20);
+    std::remove(path.c_str());
+}
+
+
+int main() {
+    testEncodingOrder();
+    testArrayOrder();
+    testAssign();
+    testSnapshotWithNaN();
+    return testResult();
+}
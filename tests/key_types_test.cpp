@@ -0,0 +1,162 @@
+//   File: key_types_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: CursedArray with double, integer, FixedPoint, and string indexes, and custom comparators.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "../RedBlack_Augments.h"
+#include "Test_Check.h"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// Orders integers from largest to smallest
+struct Descending {
+    static int compare(int a, int b) { return int(a < b) - int(a > b); }
+};
+
+
+/**
+ * Double indexes keep precision a float would round away.
+ */
+void testDoubleKeys() {
+    std::mt19937_64 rng(5);
+    CursedArray<int, RedBlackTree, double> array;
+    std::map<double, int> model;
+
+    // Microsecond steps on epoch-sized values collapse in a float
+    for (int i = 0; i < 5000; ++i) {
+        double key = 1.7e9 + double(rng() % 100000) * 1e-6;
+        array[key] = i;
+        model[key] = i;
+    }
+
+    CHECK(array.size() == int(model.size()));
+    auto it = array.begin();
+    for (const auto & pair : model) {
+        CHECK(it.key() == pair.first and *it == pair.second);
+        ++it;
+    }
+    CHECK(array.lower_bound(1.7e9 + 0.05).key() == model.lower_bound(1.7e9 + 0.05)->first);
+}
+
+
+/**
+ * Integer indexes, including the order-statistic storage.
+ */
+void testIntegerKeys() {
+    CursedArray<int, OrderStatisticTree, int64_t> array;
+    for (int i = 0; i < 100; ++i)
+        array[int64_t(i * 3 - 50)] = i;
+
+    CHECK(array.rank(int64_t(1)) == 17);
+    CHECK(array.select(0).key() == -50);
+    CHECK(array[int64_t(16777217)] == 0);
+
+    // Integers a float cannot tell apart
+    CursedArray<int, RedBlackTree, int> exact;
+    exact[16777216] = 1;
+    exact[16777217] = 2;
+    CHECK(exact.size() == 2 and exact[16777217] == 2);
+
+    std::vector<int64_t> keys = {5, -3, 5};
+    std::vector<int> values = {1, 2, 3};
+    CursedArray<int, RedBlackTree, int64_t> assigned;
+    assigned.assign(keys.begin(), keys.end(), values.begin());
+    CHECK(assigned.size() == 2 and assigned[int64_t(5)] == 3 and assigned.begin().key() == -3);
+}
+
+
+/**
+ * FixedPoint indexes order by their raw integer, in either storage and frozen.
+ */
+void testFixedPointKeys() {
+    using Fixed = FixedPoint<int64_t, 32>;
+    std::mt19937_64 rng(9);
+    CursedArray<int, BPlusTree, Fixed> array;
+    std::map<int64_t, int> model;
+
+    for (int i = 0; i < 3000; ++i) {
+        Fixed key(double(int64_t(rng() % 2000000) - 1000000) / 1024.0);
+        array[key] = i;
+        model[key.raw] = i;
+    }
+
+    auto it = array.begin();
+    for (const auto & pair : model) {
+        CHECK(it.key().raw == pair.first and *it == pair.second);
+        ++it;
+    }
+
+    array.freeze();
+    for (const auto & pair : model)
+        CHECK(array[Fixed::fromRaw(pair.first)] == pair.second);
+
+    CHECK(Fixed(1.5).toDouble() == 1.5);
+    CHECK(Fixed(-1.5) < Fixed(-1.25));
+}
+
+
+/**
+ * String indexes sort lexicographically.
+ */
+void testStringKeys() {
+    CursedArray<std::string, RedBlackTree, std::string> array;
+    array["b"] = "2";
+    array["a"] = std::string("1");
+    array["c"] = "3";
+
+    std::string keys;
+    for (auto it = array.begin(); it != array.end(); ++it)
+        keys += it.key();
+    CHECK(keys == "abc");
+    CHECK(std::string(array["b"]) == "2");
+
+    CHECK(array.remove("b"));
+    CHECK(array.size() == 2);
+    array.freeze();
+    CHECK(std::string(array["c"]) == "3");
+    CHECK(array.lower_bound("bb").key() == "c");
+
+    std::vector<std::string> names = {"b", "a", "b"};
+    std::vector<int> values = {1, 2, 3};
+    CursedArray<int, RedBlackTree, std::string> assigned;
+    assigned.assign(names.begin(), names.end(), values.begin());
+    CHECK(assigned.size() == 2 and assigned["b"] == 3);
+}
+
+
+/**
+ * A tree takes a comparator in place of KeyCompare.
+ */
+void testCustomComparator() {
+    RedBlackTree<int, int, NoAugment, Descending> tree;
+    for (int i = 0; i < 10; ++i)
+        tree.insert(i, i);
+
+    CHECK(tree.begin().key() == 9);
+    CHECK(*tree.findValue(4) == 4);
+    CHECK(tree.remove(4));
+    CHECK(!tree.findValue(4));
+
+    int expected = 9;
+    tree.visitInOrder([&](const int & key, int &) {
+        if (expected == 4)
+            --expected;
+        CHECK(key == expected--);
+    });
+}
+
+
+int main() {
+    testDoubleKeys();
+    testIntegerKeys();
+    testFixedPointKeys();
+    testStringKeys();
+    testCustomComparator();
+    return testResult();
+}
@@ -0,0 +1,123 @@
+//   File: lazy_add_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: LazyAddTree addToAll() and addToRange() checked against a std::map.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <map>
+#include <random>
+
+/**
+ * Random writes, removes, and range adds interleaved with lookups and scans.
+ */
+void testAgainstMap() {
+    std::mt19937 rng(7);
+
+    for (int round = 0; round < 20; ++round) {
+        LazyAddTree<int, long> tree;
+        std::map<int, long> model;
+
+        for (int step = 0; step < 3000; ++step) {
+            int choice = int(rng() % 10);
+            int key = int(rng() % 500);
+
+            if (choice < 3) {
+                long value = long(rng() % 100);
+                tree.insert(key, value);
+                model[key] = value;
+            }
+            else if (choice < 4) {
+                CHECK(tree.remove(key) == (model.erase(key) == 1));
+            }
+            else if (choice < 5) {
+                long delta = long(rng() % 21) - 10;
+                tree.addToAll(delta);
+                for (auto & pair : model)
+                    pair.second += delta;
+            }
+            else if (choice < 7) {
+                int high = key + int(rng() % 100);
+                long delta = long(rng() % 21) - 10;
+                tree.addToRange(key, high, delta);
+                for (auto it = model.lower_bound(key); it != model.end() and it->first <= high; ++it)
+                    it->second += delta;
+            }
+            else if (choice < 8) {
+                long* value = tree.findValue(key);
+                auto expected = model.find(key);
+                CHECK((value != nullptr) == (expected != model.end()));
+                if (value and expected != model.end())
+                    CHECK(*value == expected->second);
+            }
+            else if (choice < 9) {
+                // Writes through a cursedInsert() reference see pending adds first
+                if (model.count(key)) {
+                    tree.cursedInsert(key) += 3;
+                    model[key] += 3;
+                }
+            }
+            else {
+                auto it = tree.lower_bound(key);
+                auto expected = model.lower_bound(key);
+                for (int i = 0; i < 5 and expected != model.end(); ++i, ++it, ++expected)
+                    CHECK(it.key() == expected->first and *it == expected->second);
+            }
+        }
+
+        auto expected = model.begin();
+        tree.visitInOrder([&](const int & key, long & value) {
+            CHECK(key == expected->first and value == expected->second);
+            ++expected;
+        });
+        CHECK(expected == model.end());
+
+        // Backwards too, since iterators push tags down on the way
+        auto reverse = model.rbegin();
+        for (auto it = tree.end(); reverse != model.rend(); ++reverse) {
+            --it;
+            CHECK(it.key() == reverse->first and *it == reverse->second);
+        }
+    }
+}
+
+
+/**
+ * CursedArray forwards the adds, mapping index bounds to stored keys, frozen or not.
+ */
+void testCursedArray() {
+    CursedArray<int, LazyAddTree> array;
+    for (int i = 0; i < 100; ++i)
+        array[float(i)] = i;
+
+    array.addToAll(10);
+    array.addToRange(10.f, 19.5f, 100);
+    CHECK(array[5.f] == 15 and array[15.f] == 125 and array[20.f] == 30);
+
+    array.freeze();
+    array.addToRange(0.f, 1.f, 1);
+    array.addToAll(1);
+    CHECK(array[0.f] == 12 and array[2.f] == 13);
+
+    // Bounds are logical indexes, so they follow a shift
+    array += 1000.f;
+    array.addToRange(1050.f, 1051.f, -1000);
+    CHECK(array[1050.f] == 61 - 1000 and array[1052.f] == 63 and array[50.f] == 0);
+
+    // A range between saved indexes, or with inverted bounds, changes nothing
+    array.addToRange(1060.5f, 1060.7f, 5);
+    array.addToRange(1070.f, 1060.f, 5);
+    CHECK(array[1060.f] == 71 and array[1061.f] == 72 and array[1065.f] == 76);
+    array.thaw();
+    array.addToRange(1070.f, 1060.f, 5);
+    CHECK(array[1060.f] == 71 and array[1065.f] == 76);
+}
+
+
+int main() {
+    testAgainstMap();
+    testCursedArray();
+    return testResult();
+}
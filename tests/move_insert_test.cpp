@@ -0,0 +1,130 @@
+//   File: move_insert_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Values reach the tree by move or in-place construction, never by copy.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <memory>
+#include <string>
+
+// Counts how it was constructed and assigned
+struct Counted {
+    static int copies;
+    static int moves;
+    static int constructions;
+    std::string text;
+
+    Counted() { ++constructions; }
+    Counted(const std::string & t, int repeat) : text() {
+        ++constructions;
+        for (int i = 0; i < repeat; ++i)
+            text += t;
+    }
+    Counted(const Counted & other) : text(other.text) { ++copies; }
+    Counted(Counted && other) noexcept : text(std::move(other.text)) { ++moves; }
+    Counted & operator=(const Counted & other) { text = other.text; ++copies; return *this; }
+    Counted & operator=(Counted && other) noexcept { text = std::move(other.text); ++moves; return *this; }
+
+    static void reset() { copies = moves = constructions = 0; }
+};
+int Counted::copies = 0;
+int Counted::moves = 0;
+int Counted::constructions = 0;
+
+
+/**
+ * Rvalue writes, try_emplace(), emplace(), and insert_or_assign() make no copies.
+ * @param buildsInPlace - True if the storage constructs emplaced values in their node;
+ *                        BPlusTree builds them once and moves them into its leaf arrays.
+ */
+template <template <typename...> class Storage>
+void testNoCopies(bool buildsInPlace) {
+    CursedArray<Counted, Storage> array;
+
+    Counted::reset();
+    array[1.f] = Counted("a", 3);
+    CHECK(Counted::copies == 0 and Counted::moves == 1);
+
+    Counted::reset();
+    array[1.f] = Counted("b", 1);       // Overwrite: one move-assignment
+    CHECK(Counted::copies == 0 and Counted::moves == 1);
+
+    Counted::reset();
+    auto placed = array.try_emplace(2.f, "c", 2);
+    CHECK(placed.second and placed.first->text == "cc");
+    CHECK(Counted::copies == 0);
+    if (buildsInPlace)
+        CHECK(Counted::constructions == 1 and Counted::moves == 0);
+
+    // An existing index builds nothing
+    Counted::reset();
+    placed = array.try_emplace(2.f, "d", 2);
+    CHECK(!placed.second and placed.first->text == "cc");
+    CHECK(Counted::constructions == 0 and Counted::copies == 0 and Counted::moves == 0);
+
+    Counted::reset();
+    placed = array.emplace(3.f, "e", 1);
+    CHECK(placed.second and Counted::copies == 0);
+
+    Counted::reset();
+    Counted value("f", 4);
+    placed = array.insert_or_assign(3.f, std::move(value));
+    CHECK(!placed.second and placed.first->text == "ffff");
+    CHECK(Counted::copies == 0 and Counted::moves == 1);
+
+    placed = array.insert_or_assign(4.f, Counted("g", 1));
+    CHECK(placed.second and array.size() == 4);
+
+    // Lvalue writes still copy, exactly once
+    Counted::reset();
+    Counted lvalue("h", 1);
+    array[5.f] = lvalue;
+    CHECK(Counted::copies == 1);
+}
+
+
+/**
+ * Move-only values can be stored at all.
+ */
+void testMoveOnlyValues() {
+    CursedArray<std::unique_ptr<int>> array;
+    array[1.f] = std::make_unique<int>(1);
+    array.try_emplace(2.f, new int(2));
+    array.insert_or_assign(1.f, std::make_unique<int>(10));
+
+    CHECK(array.size() == 2);
+    CHECK(**array.try_emplace(1.f).first == 10);
+    CHECK(**array.try_emplace(2.f).first == 2);
+}
+
+
+/**
+ * Writing to a frozen array thaws it and still makes no copies.
+ */
+void testFrozenWrites() {
+    CursedArray<Counted> array;
+    for (int i = 0; i < 10; ++i)
+        array.try_emplace(float(i), "x", i);
+    array.freeze();
+
+    Counted::reset();
+    auto placed = array.try_emplace(3.f, "y", 1);
+    CHECK(!placed.second and placed.first->text == "xxx");
+    CHECK(Counted::copies == 0);
+
+    placed = array.try_emplace(30.f, "y", 1);
+    CHECK(placed.second and array.size() == 11);
+    CHECK(Counted::copies == 0);
+}
+
+
+int main() {
+    testNoCopies<RedBlackTree>(true);
+    testNoCopies<BPlusTree>(false);
+    testMoveOnlyValues();
+    testFrozenWrites();
+    return testResult();
+}
@@ -0,0 +1,141 @@
+//   File: mpmc_queue_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: MPMCQueue bounds, batches, and exactly-once delivery across threads.
+// ---------------------------------------------------------------------
+
+#include "../MPMC_Queue.h"
+#include "Test_Check.h"
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * The try* calls report full and empty instead of waiting.
+ */
+void testBounds() {
+    MPMCQueue<int> queue(5);
+    CHECK(queue.capacity() == 8);
+
+    int value = -1;
+    CHECK(!queue.tryDeque(value));
+    for (int i = 0; i < 8; ++i)
+        CHECK(queue.tryEnqueue(i));
+    CHECK(!queue.tryEnqueue(8));
+    CHECK(queue.sizeApprox() == 8);
+
+    // Wrap around the ring a few times
+    for (int i = 8; i < 40; ++i) {
+        CHECK(queue.tryDeque(value) and value == i - 8);
+        CHECK(queue.tryEnqueue(i));
+    }
+    for (int i = 32; i < 40; ++i)
+        CHECK(queue.tryDeque(value) and value == i);
+    CHECK(queue.sizeApprox() == 0);
+
+    MPMCQueue<std::unique_ptr<int>> pointers(4);
+    CHECK(pointers.tryEnqueue(std::make_unique<int>(7)));
+    std::unique_ptr<int> pointer;
+    CHECK(pointers.tryDeque(pointer) and *pointer == 7);
+}
+
+
+/**
+ * Batches take what fits and keep their values contiguous and in order.
+ */
+void testBatches() {
+    MPMCQueue<int> queue(16);
+    std::vector<int> values;
+    for (int i = 0; i < 20; ++i)
+        values.push_back(i);
+
+    CHECK(queue.tryEnqueueBatch(values.begin(), 20) == 16);
+    CHECK(queue.tryEnqueueBatch(values.begin(), 1) == 0);
+
+    std::vector<int> out;
+    CHECK(queue.tryDequeBatch(std::back_inserter(out), 10) == 10);
+    CHECK(queue.dequeBatch(std::back_inserter(out), 10) == 6);
+    CHECK(out.size() == 16);
+    for (int i = 0; i < 16; ++i)
+        CHECK(out[i] == i);
+    CHECK(queue.tryDequeBatch(std::back_inserter(out), 10) == 0);
+}
+
+
+/**
+ * Producers and consumers through a small queue: every value arrives exactly once,
+ * and each consumer sees any one producer's values in order.
+ */
+void testManyProducersAndConsumers() {
+    const int producers = 3;
+    const int consumers = 3;
+    const int perProducer = 20000;
+    MPMCQueue<int> queue(64);
+
+    std::vector<std::atomic<int>> seen(producers * perProducer);
+    std::atomic<int> outOfOrder{0};
+    std::atomic<int> remaining{producers * perProducer};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            std::vector<int> batch;
+            for (int i = 0; i < perProducer; ++i) {
+                // Mix single and batched enqueues, flushing the batch first to keep order
+                if (i % 11 == 0) {
+                    queue.enqueueBatch(batch.begin(), int(batch.size()));
+                    batch.clear();
+                    queue.enqueue(p * perProducer + i);
+                    continue;
+                }
+                batch.push_back(p * perProducer + i);
+                if (batch.size() == 8) {
+                    queue.enqueueBatch(batch.begin(), int(batch.size()));
+                    batch.clear();
+                }
+            }
+            queue.enqueueBatch(batch.begin(), int(batch.size()));
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            std::vector<int> lastFrom(producers, -1);
+            std::vector<int> out;
+            while (remaining.load() > 0) {
+                out.clear();
+                if (queue.tryDequeBatch(std::back_inserter(out), 4) == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (int value : out) {
+                    int producer = value / perProducer;
+                    if (value <= lastFrom[producer])
+                        outOfOrder.fetch_add(1);
+                    lastFrom[producer] = value;
+
+                    seen[value].fetch_add(1);
+                    remaining.fetch_sub(1);
+                }
+            }
+        });
+    }
+    for (std::thread & thread : threads)
+        thread.join();
+
+    int missingOrDuplicated = 0;
+    for (auto & count : seen)
+        missingOrDuplicated += (count.load() != 1);
+    CHECK(missingOrDuplicated == 0);
+    CHECK(outOfOrder.load() == 0);
+}
+
+
+int main() {
+    testBounds();
+    testBatches();
+    testManyProducersAndConsumers();
+    return testResult();
+}
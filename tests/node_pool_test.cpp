@@ -0,0 +1,95 @@
+//   File: node_pool_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: NodePool reuse and RedBlackTree node lifetimes.
+// ---------------------------------------------------------------------
+
+#include "../RedBlack_Tree.h"
+#include "Test_Check.h"
+
+#include <string>
+#include <vector>
+
+// Counts live instances, so missed or doubled destructor calls show up
+struct Tracked {
+    static int live;
+    int id = 0;
+
+    Tracked() { ++live; }
+    explicit Tracked(int id) : id{id} { ++live; }
+    Tracked(const Tracked & other) : id{other.id} { ++live; }
+    Tracked & operator =(const Tracked &) = default;
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+
+
+void testSlotsAreReused() {
+    NodePool<Tracked> pool;
+    std::vector<Tracked*> nodes;
+
+    for (int i = 0; i < 1000; ++i)
+        nodes.push_back(pool.create(i));
+    std::size_t reserved = pool.bytesReserved();
+    CHECK(reserved >= 1000 * sizeof(Tracked));
+    CHECK(Tracked::live == 1000);
+
+    // Destroyed slots are handed out again before any new slab is allocated
+    for (Tracked* node : nodes)
+        pool.destroy(node);
+    CHECK(Tracked::live == 0);
+
+    for (int i = 0; i < 1000; ++i)
+        CHECK(pool.create(i)->id == i);
+    CHECK(pool.bytesReserved() == reserved);
+
+    pool.releaseAll();
+    CHECK(pool.bytesReserved() == 0);
+    Tracked::live = 0;      // releaseAll() skips destructors by design
+}
+
+
+void testTreeDestroysValues() {
+    {
+        RedBlackTree<int, Tracked> tree;
+        for (int i = 0; i < 500; ++i)
+            tree.insert(i, Tracked(i));
+        CHECK(Tracked::live == 500);
+
+        for (int i = 0; i < 500; i += 2)
+            CHECK(tree.remove(i));
+        CHECK(Tracked::live == 250);
+
+        tree.clear();
+        CHECK(Tracked::live == 0);
+        CHECK(tree.size() == 0);
+
+        for (int i = 0; i < 100; ++i)
+            tree.insert(i, Tracked(i));
+    }
+    CHECK(Tracked::live == 0);
+}
+
+
+void testStringValuesSurviveReuse() {
+    RedBlackTree<int, std::string> tree;
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 300; ++i)
+            tree.insert(i, std::string(40, char('a' + round)) + std::to_string(i));
+        for (int i = 0; i < 300; i += 3)
+            tree.remove(i);
+    }
+
+    CHECK(tree.size() == 200);
+    CHECK(tree.findValue(0) == nullptr);
+    CHECK(tree.findValue(1) and *tree.findValue(1) == std::string(40, 'c') + "1");
+}
+
+
+int main() {
+    testSlotsAreReused();
+    testTreeDestroysValues();
+    testStringValuesSurviveReuse();
+    return testResult();
+}
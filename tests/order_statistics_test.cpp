@@ -0,0 +1,73 @@
+//   File: order_statistics_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: rank() and select() on OrderStatisticTree and frozen arrays.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+void testTreeAgainstSortedSet() {
+    std::mt19937 random(8);
+    OrderStatisticTree<int, int> tree;
+    std::set<int> expected;
+
+    for (int step = 0; step < 30000; ++step) {
+        int key = int(random() % 3000);
+        if (random() % 3 != 0) {
+            tree.insert(key, key);
+            expected.insert(key);
+        } else {
+            tree.remove(key);
+            expected.erase(key);
+        }
+
+        if (step % 1000 == 0) {
+            std::vector<int> sorted(expected.begin(), expected.end());
+            for (int probe = -1; probe <= 3000; probe += 37) {
+                int rank = int(std::lower_bound(sorted.begin(), sorted.end(), probe) - sorted.begin());
+                CHECK(tree.rank(probe) == rank);
+            }
+            for (int position = 0; position < int(sorted.size()); position += 13)
+                CHECK(tree.select(position).key() == sorted[position]);
+            CHECK(tree.select(-1) == tree.end());
+            CHECK(tree.select(int(sorted.size())) == tree.end());
+        }
+    }
+}
+
+
+void testBulkBuiltAndFrozen() {
+    std::vector<float> keys;
+    std::vector<int> values;
+    for (int i = 0; i < 777; ++i) {
+        keys.push_back(float(i) * 2.f);
+        values.push_back(i);
+    }
+
+    CursedArray<int, OrderStatisticTree> array;
+    array.assignSorted(keys.begin(), keys.end(), values.begin());
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < 777; ++i) {
+            CHECK(array.rank(float(i) * 2.f) == i);
+            CHECK(array.rank(float(i) * 2.f + 1.f) == i + 1);
+            CHECK(array.select(i).key() == float(i) * 2.f);
+        }
+        CHECK(array.select(777) == array.end());
+        array.freeze();     // Second pass answers from the implicit tree shape
+    }
+}
+
+
+int main() {
+    testTreeAgainstSortedSet();
+    testBulkBuiltAndFrozen();
+    return testResult();
+}
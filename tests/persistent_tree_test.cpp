@@ -0,0 +1,267 @@
+//   File: persistent_tree_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: PersistentRedBlackTree versions, snapshots, and lock-free readers,
+//         alone and as CursedArray storage.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+/**
+ * Inserts, overwrites, and removes on the current version.
+ */
+void testInsertRemove() {
+    PersistentRedBlackTree<int, int> tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert((i * 37) % 1000, i);
+
+    CHECK(tree.size() == 1000);
+    int value = -1;
+    CHECK(tree.findValue(37, value) and value == 1);
+
+    tree.insert(37, 500);
+    CHECK(tree.size() == 1000);
+    CHECK(tree.findValue(37, value) and value == 500);
+
+    for (int i = 0; i < 1000; i += 2)
+        CHECK(tree.remove(i));
+    CHECK(!tree.remove(0));
+    CHECK(tree.size() == 500);
+    CHECK(!tree.findValue(0, value));
+    CHECK(tree.findValue(1, value));
+}
+
+
+/**
+ * A snapshot keeps seeing its own version while writers move on.
+ */
+void testSnapshotsAreUnaffected() {
+    PersistentRedBlackTree<int, int> tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i, i);
+
+    auto before = tree.snapshot();
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i, -i);
+    for (int i = 0; i < 50; ++i)
+        tree.remove(i);
+    tree.insert(1000, 1);
+    auto after = tree.snapshot();
+
+    CHECK(before.size() == 100);
+    for (int i = 0; i < 100; ++i)
+        CHECK(before.findValue(i) and *before.findValue(i) == i);
+    CHECK(!before.findValue(1000));
+
+    CHECK(after.size() == 51);
+    CHECK(!after.findValue(0));
+    CHECK(after.findValue(60) and *after.findValue(60) == -60);
+
+    int expected = 0;
+    before.visitInOrder([&](const int & key, const int & value) {
+        CHECK(key == expected and value == expected);
+        ++expected;
+    });
+    CHECK(expected == 100);
+
+    std::vector<int> keys;
+    after.visitRange(45, 55, [&](const int & key, const int &) { keys.push_back(key); });
+    CHECK(keys.size() == 6 and keys.front() == 50 and keys.back() == 55);
+
+    // Copies share the version and outlive the original
+    auto copy = before;
+    before = after;
+    CHECK(copy.size() == 100 and before.size() == 51);
+}
+
+
+/**
+ * Readers take snapshots while a writer churns; each snapshot is internally consistent.
+ */
+void testConcurrentReaders() {
+    PersistentRedBlackTree<int, int> tree;
+    for (int i = 0; i < 256; ++i)
+        tree.insert(i, 0);
+
+    std::atomic<bool> writing{true};
+    std::atomic<int> inconsistent{0};
+    std::thread writer([&]() {
+        // Each round rewrites every key to the same generation number
+        for (int generation = 1; generation <= 200; ++generation) {
+            for (int i = 0; i < 256; ++i)
+                tree.insert(i, generation);
+        }
+        writing.store(false);
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (writing.load()) {
+                auto snapshot = tree.snapshot();
+                int previous = 1 << 30;
+                snapshot.visitInOrder([&](const int &, const int & value) {
+                    // Lower keys are rewritten first, so values never rise along the walk
+                    if (value > previous)
+                        inconsistent.fetch_add(1);
+                    previous = value;
+                });
+                if (snapshot.size() != 256)
+                    inconsistent.fetch_add(1);
+
+                int value;
+                if (!tree.findValue(128, value))
+                    inconsistent.fetch_add(1);
+            }
+        });
+    }
+
+    writer.join();
+    for (std::thread & reader : readers)
+        reader.join();
+
+    CHECK(inconsistent.load() == 0);
+    int value = 0;
+    CHECK(tree.findValue(255, value) and value == 200);
+}
+
+
+/**
+ * The storage interface CursedArray uses: in-place writes, iterators, and bounds.
+ */
+void testStorageInterface() {
+    PersistentRedBlackTree<int, int> tree;
+    for (int i = 0; i < 100; i += 2)
+        tree.insert_or_assign(i, i);
+
+    auto placed = tree.try_emplace(10, -1);
+    CHECK(!placed.second and *placed.first == 10);
+    placed = tree.try_emplace(11, 11);
+    CHECK(placed.second and *placed.first == 11);
+    placed = tree.insert_or_assign(11, 12);
+    CHECK(!placed.second and *placed.first == 12);
+
+    int expected = 0;
+    for (auto it = tree.begin(); it != tree.end(); ++it) {
+        CHECK(it.key() == expected);
+        expected += (expected == 10 or expected == 11) ? 1 : 2;
+    }
+    CHECK(expected == 100);
+
+    auto it = tree.end();
+    CHECK((--it).key() == 98);
+    CHECK(tree.lower_bound(11).key() == 11 and tree.upper_bound(11).key() == 12);
+    CHECK(tree.floor(13).key() == 12 and tree.ceil(97).key() == 98);
+    CHECK(tree.floor(-1) == tree.end() and tree.ceil(99) == tree.end());
+    CHECK((--tree.lower_bound(12)).key() == 11);
+}
+
+
+/**
+ * A CursedArray snapshot reads its own moment, including NaN, infinite, and shifted indexes.
+ */
+void testArraySnapshot() {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    CursedArray<int, PersistentRedBlackTree> array;
+    for (int i = -50; i < 50; ++i)
+        array[float(i)] = i;
+    array[nan] = 1000;
+    array[inf] = 2000;
+    array[-inf] = -2000;
+
+    auto before = array.snapshot();
+    array[nan] = 1;
+    array[0.0f] = 5;
+    array.remove(-inf);
+    ++array;
+
+    CHECK(before.size() == 103 and array.size() == 102);
+    CHECK(before[nan] == 1000 and array[nan] == 1);
+    CHECK(before[0.0f] == 0 and array[1.0f] == 5);
+    CHECK(before[-inf] == -2000 and !array.snapshot().findValue(-inf));
+
+    // In order: -inf, the finite indexes, inf, then NaN
+    std::vector<float> indexes;
+    before.visitInOrder([&](float index, const int &) { indexes.push_back(index); });
+    CHECK(indexes.size() == 103 and indexes.front() == -inf and std::isnan(indexes.back()));
+    CHECK(std::is_sorted(indexes.begin(), indexes.end() - 1));
+
+    // The shift taken with the snapshot stays with it
+    auto shifted = array.snapshot();
+    array += 0.5f;
+    CHECK(shifted[50.0f] == 49 and shifted[-49.0f] == -50 and !shifted.findValue(-50.0f));
+    CHECK(array[50.5f] == 49);
+
+    std::vector<int> values;
+    shifted.visitRange(0.5f, 3.0f, [&](float, const int & value) { values.push_back(value); });
+    CHECK((values == std::vector<int>{5, 1, 2}));
+
+    int count = 0;
+    for (auto it = array.begin(); it != array.end(); ++it)
+        ++count;
+    CHECK(count == 102);
+}
+
+
+/**
+ * Readers take array snapshots on their own threads while the writer assigns indexes.
+ */
+void testConcurrentArrayReaders() {
+    CursedArray<int, PersistentRedBlackTree> array;
+    for (int i = 0; i < 128; ++i)
+        array[float(i)] = 0;
+
+    std::atomic<bool> writing{true};
+    std::atomic<int> inconsistent{0};
+    std::thread writer([&]() {
+        for (int generation = 1; generation <= 100; ++generation) {
+            for (int i = 0; i < 128; ++i)
+                array[float(i)] = generation;
+        }
+        writing.store(false);
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&]() {
+            while (writing.load()) {
+                auto snapshot = array.snapshot();
+                int previous = 1 << 30;
+                snapshot.visitInOrder([&](float, const int & value) {
+                    if (value > previous)
+                        inconsistent.fetch_add(1);
+                    previous = value;
+                });
+                if (snapshot.size() != 128)
+                    inconsistent.fetch_add(1);
+            }
+        });
+    }
+
+    writer.join();
+    for (std::thread & reader : readers)
+        reader.join();
+
+    CHECK(inconsistent.load() == 0);
+    CHECK(array[127.0f] == 100);
+}
+
+
+int main() {
+    testInsertRemove();
+    testSnapshotsAreUnaffected();
+    testConcurrentReaders();
+    testStorageInterface();
+    testArraySnapshot();
+    testConcurrentArrayReaders();
+    return testResult();
+}
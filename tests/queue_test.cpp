@@ -0,0 +1,125 @@
+//   File: queue_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Queue ring buffer order, growth across the wrap point, and element lifetimes.
+// ---------------------------------------------------------------------
+
+#include "../Queue.h"
+#include "Test_Check.h"
+
+#include <memory>
+#include <string>
+
+// Counts live instances so leaks and double destruction show up
+struct Tracked {
+    static int live;
+    int id;
+
+    explicit Tracked(int i) : id(i) { ++live; }
+    Tracked(const Tracked & other) : id(other.id) { ++live; }
+    Tracked(Tracked && other) noexcept : id(other.id) { ++live; }
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+
+
+/**
+ * Elements come out in FIFO order, including after the head wraps and the buffer grows.
+ */
+void testOrderAcrossWrapAndGrowth() {
+    Queue<int> queue;
+    CHECK(queue.isEmpty());
+
+    int nextIn = 0;
+    int nextOut = 0;
+    // Keep the queue partly drained so the head moves before every growth
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 30 + round * 10; ++i)
+            queue.enqueue(nextIn++);
+        for (int i = 0; i < 20; ++i) {
+            CHECK(queue.peek() == nextOut);
+            CHECK(queue.deque() == nextOut++);
+        }
+    }
+
+    CHECK(queue.size() == nextIn - nextOut);
+    while (!queue.isEmpty())
+        CHECK(queue.deque() == nextOut++);
+    CHECK(nextOut == nextIn);
+}
+
+
+/**
+ * Move-only and non-trivial element types, emplace(), and reserve().
+ */
+void testElementTypes() {
+    Queue<std::unique_ptr<int>> pointers;
+    for (int i = 0; i < 40; ++i)
+        pointers.enqueue(std::make_unique<int>(i));
+    for (int i = 0; i < 40; ++i)
+        CHECK(*pointers.deque() == i);
+
+    Queue<std::string> strings;
+    strings.reserve(100);
+    std::string & first = strings.emplace(3, 'x');
+    CHECK(first == "xxx");
+    for (int i = 0; i < 100; ++i)
+        strings.enqueue(std::to_string(i));
+    CHECK(strings.deque() == "xxx");
+    CHECK(strings.deque() == "0");
+    CHECK(strings.size() == 99);
+}
+
+
+/**
+ * Enqueuing an element of the queue itself into a full queue copies it before the
+ * old buffer is freed.
+ */
+void testEnqueueOwnElement() {
+    Queue<std::string> queue;
+    queue.reserve(16);
+    queue.enqueue(std::string(40, 'a'));    // Long enough to live on the heap
+    for (int i = 1; i < 16; ++i)
+        queue.enqueue(std::to_string(i));
+
+    queue.enqueue(queue.peek());
+    CHECK(queue.size() == 17);
+    queue.emplace(queue.peek(), 0, 3);
+    for (int i = 0; i < 14; ++i)
+        queue.enqueue(std::to_string(i));
+
+    queue.enqueue(queue.peek());
+    CHECK(queue.size() == 33);
+    CHECK(queue.deque() == std::string(40, 'a'));
+    for (int i = 1; i < 16; ++i)
+        queue.deque();
+    CHECK(queue.deque() == std::string(40, 'a'));
+    CHECK(queue.deque() == "aaa");
+}
+
+
+/**
+ * Every constructed element is destroyed exactly once, by deque() or the destructor.
+ */
+void testLifetimes() {
+    {
+        Queue<Tracked> queue;
+        for (int i = 0; i < 50; ++i)
+            queue.emplace(i);
+        for (int i = 0; i < 20; ++i)
+            queue.deque();
+        for (int i = 0; i < 50; ++i)
+            queue.enqueue(Tracked(i));
+        CHECK(Tracked::live == 80);
+    }
+    CHECK(Tracked::live == 0);
+}
+
+
+int main() {
+    testOrderAcrossWrapAndGrowth();
+    testElementTypes();
+    testEnqueueOwnElement();
+    testLifetimes();
+    return testResult();
+}
@@ -0,0 +1,132 @@
+//   File: range_query_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: floor, ceil, nearest and kNearest against a brute-force search,
+//         on the tree and while frozen.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+/**
+ * Brute-force k nearest: closest first, ties to the smaller index.
+ */
+std::vector<float> bruteNearest(std::vector<float> keys, float index, int k) {
+    std::stable_sort(keys.begin(), keys.end(), [&](float a, float b) {
+        return std::fabs(a - index) < std::fabs(b - index);
+    });
+    keys.resize(std::min<size_t>(keys.size(), size_t(k)));
+    return keys;
+}
+
+
+template <typename Array>
+void checkQueries(Array & array, const std::vector<float> & keys) {
+    for (float index = -3.f; index <= 43.f; index += 0.125f) {
+        auto floorIt = array.floor(index);
+        auto below = std::upper_bound(keys.begin(), keys.end(), index);
+        CHECK((floorIt == array.end()) == (below == keys.begin()));
+        CHECK(floorIt == array.end() or floorIt.key() == *(below - 1));
+
+        auto ceilIt = array.ceil(index);
+        auto above = std::lower_bound(keys.begin(), keys.end(), index);
+        CHECK((ceilIt == array.end()) == (above == keys.end()));
+        CHECK(ceilIt == array.end() or ceilIt.key() == *above);
+
+        std::vector<float> expected = bruteNearest(keys, index, 5);
+        auto nearestIt = array.nearest(index);
+        CHECK(nearestIt == array.end() or nearestIt.key() == expected.front());
+
+        std::vector<float> found;
+        for (auto & it : array.kNearest(index, 5))
+            found.push_back(it.key());
+        CHECK(found == expected);
+    }
+}
+
+
+void testAgainstBruteForce() {
+    std::mt19937 random(7);
+    CursedArray<int> array;
+    std::vector<float> keys;
+
+    for (int i = 0; i < 60; ++i) {
+        float index = float(random() % 160) / 4.f;     // Quarter steps keep distances exact
+        if (std::find(keys.begin(), keys.end(), index) == keys.end())
+            keys.push_back(index);
+        array[index] = i;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    checkQueries(array, keys);
+    array.freeze();
+    checkQueries(array, keys);
+}
+
+
+void testEdgeCases() {
+    CursedArray<int> array;
+    CHECK(array.nearest(1.f) == array.end());
+    CHECK(array.kNearest(1.f, 3).empty());
+
+    array[1.f] = 1;
+    array[3.f] = 3;
+    CHECK(array.nearest(2.f).key() == 1.f);     // Tie goes to the smaller index
+    CHECK(array.kNearest(2.f, 10).size() == 2);
+    CHECK(array.kNearest(2.f, 0).empty());
+    CHECK(array.floor(0.f) == array.end());
+    CHECK(array.ceil(4.f) == array.end());
+}
+
+
+/**
+ * Distances are measured between indexes, not between their stored encodings, and
+ * integer distances spanning the whole key range do not overflow.
+ */
+void testDistanceOnIndexes() {
+    // -1 is 1.5 from 0.5 and 3 is 2.5 away, though their float encodings are far apart
+    CursedArray<int, BPlusTree> floats;
+    floats[-1.f] = -1;
+    floats[3.f] = 3;
+    floats[-100.f] = -100;
+    CHECK(floats.nearest(0.5f).key() == -1.f);
+    CHECK(floats.nearest(1.5f).key() == 3.f);
+    CHECK(floats.kNearest(0.5f, 3)[2].key() == -100.f);
+    floats.freeze();
+    CHECK(floats.nearest(0.5f).key() == -1.f);
+    CHECK(floats.nearest(-60.f).key() == -100.f);
+
+    CursedArray<int, RedBlackTree, int32_t> integers;
+    integers[std::numeric_limits<int32_t>::min()] = 1;
+    integers[std::numeric_limits<int32_t>::max()] = 2;
+    CHECK(integers.nearest(0).key() == std::numeric_limits<int32_t>::max());     // 2^31 - 1 away versus 2^31
+    CHECK(integers.nearest(-1).key() == std::numeric_limits<int32_t>::min());
+    CHECK(integers.kNearest(0, 2)[1].key() == std::numeric_limits<int32_t>::min());
+
+    CursedArray<int, RedBlackTree, uint32_t> unsignedIndexes;
+    unsignedIndexes[0u] = 1;
+    unsignedIndexes[std::numeric_limits<uint32_t>::max()] = 2;
+    CHECK(unsignedIndexes.nearest(5u).key() == 0u);
+    CHECK(unsignedIndexes.nearest(std::numeric_limits<uint32_t>::max() - 5).key() == std::numeric_limits<uint32_t>::max());
+
+    using Fixed = FixedPoint<int64_t, 8>;
+    CursedArray<int, RedBlackTree, Fixed> fixed;
+    fixed[Fixed::fromRaw(std::numeric_limits<int64_t>::min())] = 1;
+    fixed[Fixed::fromRaw(std::numeric_limits<int64_t>::max())] = 2;
+    CHECK(fixed.nearest(Fixed::fromRaw(1)).key() == Fixed::fromRaw(std::numeric_limits<int64_t>::max()));
+}
+
+
+int main() {
+    testAgainstBruteForce();
+    testEdgeCases();
+    testDistanceOnIndexes();
+    return testResult();
+}
@@ -0,0 +1,83 @@
+//   File: redblack_tree_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Iterative RedBlackTree insert/remove against std::map, and tree height.
+//         Built with CURSED_ARRAY_STATS for shape().
+// ---------------------------------------------------------------------
+
+#define CURSED_ARRAY_STATS
+
+#include "../RedBlack_Tree.h"
+#include "Test_Check.h"
+
+#include <cmath>
+#include <map>
+#include <random>
+
+/**
+ * A red-black tree of n keys is never taller than 2 log2(n + 1).
+ */
+template <typename Tree>
+bool heightIsBalanced(Tree & tree) {
+    int nodeCount = tree.size();
+    return tree.shape().height <= 2.0 * std::log2(double(nodeCount) + 1.0) + 1e-9;
+}
+
+
+void testRandomOperations() {
+    std::mt19937 random(5);
+    RedBlackTree<int, int> tree;
+    std::map<int, int> expected;
+
+    for (int step = 0; step < 200000; ++step) {
+        int key = int(random() % 20000);
+
+        if (random() % 3 != 0) {
+            tree.insert(key, step);
+            expected[key] = step;
+        } else {
+            CHECK(tree.remove(key) == (expected.erase(key) == 1));
+        }
+
+        if (step % 20000 == 0)
+            CHECK(heightIsBalanced(tree));
+    }
+
+    CHECK(tree.size() == int(expected.size()));
+    auto want = expected.begin();
+    tree.visitInOrder([&](int key, int value) {
+        CHECK(key == want->first and value == want->second);
+        ++want;
+    });
+    CHECK(want == expected.end());
+
+    for (auto & pair : expected)
+        CHECK(tree.remove(pair.first));
+    CHECK(tree.size() == 0 and tree.begin() == tree.end());
+}
+
+
+void testSortedInsertsStayShallow() {
+    // Ascending and descending runs are the worst case for an unbalanced tree
+    // and would overflow the stack in a recursive one
+    RedBlackTree<int, int> tree;
+    for (int key = 0; key < 1000000; ++key)
+        tree.insert(key, key);
+    CHECK(heightIsBalanced(tree));
+
+    for (int key = 0; key < 1000000; key += 2)
+        tree.remove(key);
+    for (int key = -1; key > -500000; --key)
+        tree.insert(key, key);
+    CHECK(tree.size() == 500000 + 499999);
+    CHECK(heightIsBalanced(tree));
+    CHECK(*tree.findValue(-499999) == -499999);
+    CHECK(tree.findValue(0) == nullptr);
+}
+
+
+int main() {
+    testRandomOperations();
+    testSortedInsertsStayShallow();
+    return testResult();
+}
@@ -0,0 +1,138 @@
+//   File: sharded_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: ShardedCursedArray routing, traversal, and rebalancing.
+// ---------------------------------------------------------------------
+
+#include "../Sharded_CursedArray.h"
+#include "Test_Check.h"
+
+#include <limits>
+#include <thread>
+#include <vector>
+
+/**
+ * Keys inside and outside the expected range land somewhere and read back.
+ */
+void testRouting() {
+    ShardedCursedArray<int> array(4, 0.f, 100.f);
+    for (int i = -50; i < 150; ++i)
+        array[float(i)] = i * 2;
+
+    CHECK(array.size() == 200);
+    for (int i = -50; i < 150; ++i)
+        CHECK(array.get(float(i)) == i * 2);
+    CHECK(array.get(1000.f) == 0);
+
+    CHECK(array.remove(10.f));
+    CHECK(!array.remove(10.f));
+    CHECK(array.size() == 199);
+}
+
+
+/**
+ * Traversal crosses shard boundaries in ascending order.
+ */
+void testTraversal() {
+    ShardedCursedArray<int> array(8, 0.f, 80.f);
+    for (int i = 79; i >= 0; --i)
+        array.set(float(i), i);
+
+    std::vector<float> keys;
+    array.visitInOrder([&](const float & key, int & value) {
+        CHECK(int(key) == value);
+        keys.push_back(key);
+    });
+    CHECK(keys.size() == 80);
+    for (size_t i = 1; i < keys.size(); ++i)
+        CHECK(keys[i - 1] < keys[i]);
+
+    std::vector<float> range;
+    array.visitRange(15.f, 45.f, [&](const float & key, int &) { range.push_back(key); });
+    CHECK(range.size() == 31);
+    CHECK(range.front() == 15.f and range.back() == 45.f);
+}
+
+
+/**
+ * rebalance() evens out shards that a skewed key range piled into one.
+ */
+void testRebalance() {
+    ShardedCursedArray<int> array(4, 0.f, 1.f);
+    for (int i = 0; i < 4000; ++i)
+        array.set(100.f + float(i), i);
+
+    array.rebalance();
+    auto stats = array.shardStats();
+    CHECK(stats.size() == 4);
+    for (const auto & shard : stats)
+        CHECK(shard.size == 1000);
+    for (size_t i = 1; i < stats.size(); ++i)
+        CHECK(stats[i - 1].lowIndex < stats[i].lowIndex);
+
+    CHECK(array.size() == 4000);
+    for (int i = 0; i < 4000; i += 7)
+        CHECK(array.get(100.f + float(i)) == i);
+}
+
+
+/**
+ * Parallel writers, with automatic rebalancing kicking in along the way.
+ */
+void testParallelWriters() {
+    const int threadCount = 4;
+    const int perThread = 40000;
+    ShardedCursedArray<int> array(8, 0.f, 1.f);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i)
+                array.set(float(t * perThread + i), i);
+        });
+    }
+    for (std::thread & thread : threads)
+        thread.join();
+
+    CHECK(array.size() == threadCount * perThread);
+    for (int key = 0; key < threadCount * perThread; key += 101)
+        CHECK(array.get(float(key)) == key % perThread);
+}
+
+
+/**
+ * NaN and -0.0 indexes route on their encodings and leave the other keys findable.
+ */
+void testSpecialIndexes() {
+    ShardedCursedArray<int> array(4, 0.f, 200.f);
+    array.set(std::numeric_limits<float>::quiet_NaN(), -1);
+    for (int i = 0; i < 200; ++i)
+        array.set(float(i), i);
+
+    CHECK(array.size() == 201);
+    CHECK(array.get(150.f) == 150);
+    CHECK(array.get(std::numeric_limits<float>::quiet_NaN()) == -1);
+    CHECK(array.get(-0.f) == 0);
+
+    array.rebalance();
+    CHECK(array.size() == 201);
+    for (int i = 0; i < 200; ++i)
+        CHECK(array.get(float(i)) == i);
+
+    // NaN sorts after every number
+    int visited = 0;
+    float last = 0.f;
+    array.visitInOrder([&](const float & key, int &) { ++visited; last = key; });
+    CHECK(visited == 201);
+    CHECK(last != last);
+}
+
+
+int main() {
+    testRouting();
+    testTraversal();
+    testRebalance();
+    testParallelWriters();
+    testSpecialIndexes();
+    return testResult();
+}
@@ -0,0 +1,192 @@
+//   File: shift_scale_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: O(1) shifting and scaling of every CursedArray index.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+/**
+ * Shifts move lookups, iteration, and searches together; new writes land where asked.
+ */
+void testShift() {
+    CursedArray<int> array;
+    for (int i = 0; i < 1000; ++i)
+        array[float(i)] = i;
+
+    ++array;
+    CHECK(array[1.f] == 0 and array[1000.f] == 999 and array[0.f] == 0);
+    CHECK(array.size() == 1000);
+
+    array += 100.f;
+    CHECK(array[101.f] == 0);
+    CHECK(array.begin().key() == 101.f);
+    CHECK(std::prev(array.end()).key() == 1100.f);
+
+    array += -101.f;
+    CHECK(array[0.f] == 0 and array[-0.f] == 0);
+    array[5000.f] = 7;
+    CHECK(array[5000.f] == 7);
+    CHECK(std::prev(array.end()).key() == 5000.f);
+
+    CHECK(array.lower_bound(10.5f).key() == 11.f);
+    CHECK(array.floor(10.5f).key() == 10.f);
+    CHECK(array.nearest(10.4f).key() == 10.f);
+    CHECK(array.remove(0.f) and array.size() == 1000);
+
+    // A thousand small steps there and back still find the original index
+    CursedArray<int> drifting;
+    drifting[0.25f] = 1;
+    for (int i = 0; i < 1000; ++i)
+        drifting += 0.1f;
+    for (int i = 0; i < 1000; ++i)
+        drifting += -0.1f;
+    CHECK(drifting[drifting.begin().key()] == 1);
+}
+
+
+/**
+ * Scaling multiplies every index; only positive, finite factors are taken.
+ */
+void testScale() {
+    CursedArray<int> array;
+    for (int i = 0; i < 100; ++i)
+        array[float(i)] = i;
+
+    CHECK(array.scaleIndexes(2.0));
+    CHECK(array[2.f] == 1 and array.begin().key() == 0.f);
+    CHECK(array[3.f] == 0);
+    CHECK(!array.scaleIndexes(-1.0));
+    CHECK(!array.scaleIndexes(0.0));
+    CHECK(array[198.f] == 99);
+
+    // Shift after scale, across a freeze and thaw
+    array.freeze();
+    CHECK(array[2.f] == 1);
+    array += 1.f;
+    CHECK(array[3.f] == 1);
+    array.thaw();
+    CHECK(array[3.f] == 1);
+    for (auto it = array.begin(); it != array.end(); ++it)
+        CHECK(array[it.key()] == *it);
+
+    // assign() starts again from the identity mapping
+    std::vector<float> keys = {1.f, 2.f};
+    std::vector<int> values = {1, 2};
+    array.assign(keys.begin(), keys.end(), values.begin());
+    CHECK(array.keyOffset() == 0 and array.keyScale() == 1 and array[1.f] == 1);
+}
+
+
+/**
+ * Fractional and large indexes that a shift would round: every index read back from
+ * an iterator finds its value again, and no two saved indexes are equal.
+ */
+void testRoundedShift() {
+    CursedArray<int> fractional;
+    fractional[0.1f] = 1;
+    fractional += 1000.f;
+    CHECK(fractional[fractional.begin().key()] == 1);
+    CHECK(fractional[0.1f + 1000.f] == 1);
+    CHECK(fractional.begin().key() == 0.1f + 1000.f);
+
+    // Indexes that round to the same float merge, keeping the greatest one's value
+    CursedArray<int> large;
+    for (int i = 0; i < 10; ++i)
+        large[float(i) * 0.1f] = i;
+    large += 1e8f;
+    CHECK(large.size() == 1 and large.begin().key() == 1e8f and large[1e8f] == 9);
+    large[1e8f] = 42;
+    CHECK(large.size() == 1 and large[1e8f] == 42);
+
+    // Fractional shifts and scales, checked index by index against plain float arithmetic
+    CursedArray<int> array;
+    for (int i = 0; i < 500; ++i)
+        array[float(i) * 0.37f] = i;
+    array += 3.3f;
+    CHECK(array.scaleIndexes(1.5));
+    array += 1e4f;
+
+    float previous = -std::numeric_limits<float>::infinity();
+    int count = 0;
+    for (auto it = array.begin(); it != array.end(); ++it, ++count) {
+        CHECK(it.key() > previous);
+        CHECK(array[it.key()] == *it);
+        CHECK(array.lower_bound(it.key()) == it and array.floor(it.key()) == it);
+        previous = it.key();
+    }
+    CHECK(count == array.size() and count == 500);
+    CHECK(array[(0.37f * 7 + 3.3f) * 1.5f + 1e4f] == 7);
+}
+
+
+/**
+ * Whole-number shifts and power-of-two scales of whole-number indexes fold in lazily,
+ * and searches between saved indexes still land on the right neighbor.
+ */
+void testLazyShift() {
+    CursedArray<int> array;
+    for (int i = 0; i < 1000; ++i)
+        array[float(i)] = i;
+
+    array += 5.f;
+    CHECK(array.scaleIndexes(0.5));
+    array += 0.25f;
+    CHECK(array.keyOffset() == 2.75 and array.keyScale() == 0.5);
+
+    CHECK(array[3.75f] == 2);
+    CHECK(array[3.8f] == 0 and array.size() == 1000);
+    CHECK(array.lower_bound(3.8f).key() == 4.25f);
+    CHECK(array.upper_bound(3.75f).key() == 4.25f);
+    CHECK(array.floor(3.8f).key() == 3.75f);
+    CHECK(array.ceil(3.75f).key() == 3.75f);
+    CHECK(!array.remove(3.8f) and array.size() == 1000);
+
+    // No float key maps onto 1e7 - 2.75, so writing it folds the offset into the keys
+    array[1e7f] = -1;
+    CHECK(array.keyOffset() == 0 and array.keyScale() == 1);
+    CHECK(array[1e7f] == -1 and array[3.75f] == 2 and array[4.25f] == 3);
+    CHECK(array.size() == 1001);
+}
+
+
+/**
+ * Integer, FixedPoint, and double indexes shift too.
+ */
+void testOtherKeyTypes() {
+    CursedArray<int, RedBlackTree, int64_t> integers;
+    integers[int64_t(5)] = 1;
+    integers += int64_t(10);
+    CHECK(integers[int64_t(15)] == 1 and integers.begin().key() == 15);
+    ++integers;
+    CHECK(integers[int64_t(16)] == 1);
+
+    using Fixed = FixedPoint<int64_t, 16>;
+    CursedArray<int, BPlusTree, Fixed> fixed;
+    fixed[Fixed(1.5)] = 3;
+    fixed += Fixed(0.25);
+    CHECK(fixed[Fixed(1.75)] == 3);
+    ++fixed;
+    CHECK(fixed.begin().key() == Fixed(2.75));
+
+    CursedArray<int, RedBlackTree, double> doubles;
+    doubles[1e9] = 1;
+    doubles += 0.5;
+    CHECK(doubles[1e9 + 0.5] == 1);
+}
+
+
+int main() {
+    testShift();
+    testScale();
+    testRoundedShift();
+    testLazyShift();
+    testOtherKeyTypes();
+    return testResult();
+}
@@ -0,0 +1,198 @@
+//   File: snapshot_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: CursedArray save()/load() round trips and the MappedCursedArray view.
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+struct Point {
+    double x;
+    int y;
+};
+
+/**
+ * @return Returns a scratch file path unique to this process.
+ */
+std::string scratchPath(const char* name) {
+    return "/tmp/cursed_snapshot_test_" + std::to_string(::getpid()) + "_" + name;
+}
+
+
+/**
+ * save() then load() restores every pair, frozen or not.
+ */
+void testRoundTrip() {
+    std::string path = scratchPath("round_trip");
+    CursedArray<Point> array;
+    for (int i = 0; i < 5000; ++i)
+        array[float(i) * 0.5f - 100.f] = Point{i * 1.5, -i};
+
+    CHECK(array.save(path));
+    CursedArray<Point> loaded;
+    loaded[12345.f] = Point{1, 1};      // Replaced by load()
+    CHECK(loaded.load(path));
+    CHECK(loaded.size() == 5000);
+    CHECK(loaded.lower_bound(12345.f) == loaded.end());
+    for (int i = 0; i < 5000; i += 17) {
+        Point point = loaded[float(i) * 0.5f - 100.f];
+        CHECK(point.x == i * 1.5 and point.y == -i);
+    }
+
+    // A frozen array saves the same file
+    array.freeze();
+    CHECK(array.save(path));
+    CursedArray<Point, BPlusTree> reloaded;
+    CHECK(reloaded.load(path));
+    CHECK(reloaded.size() == 5000);
+
+    // A bare file name lands in, and syncs, the working directory
+    std::string relativePath = "cursed_snapshot_test_" + std::to_string(::getpid());
+    CHECK(array.save(relativePath));
+    CHECK(loaded.load(relativePath));
+    CHECK(loaded.size() == 5000);
+    std::remove(relativePath.c_str());
+
+    CursedArray<Point> empty;
+    CHECK(empty.save(path));
+    CHECK(loaded.load(path));
+    CHECK(loaded.size() == 0);
+    std::remove(path.c_str());
+}
+
+
+/**
+ * The mapped view answers lookups in place.
+ */
+void testMappedView() {
+    std::string path = scratchPath("mapped");
+    CursedArray<int> array;
+    for (int i = 0; i < 1000; ++i)
+        array[float(i * 3)] = i;
+    CHECK(array.save(path));
+
+    MappedCursedArray<int> view;
+    CHECK(!view.isOpen());
+    CHECK(view.open(path));
+    CHECK(view.isOpen() and view.size() == 1000);
+    CHECK(view[300.f] == 100);
+    CHECK(view.findValue(301.f) == nullptr);
+    CHECK(view.findValue(-1.f) == nullptr);
+    CHECK(view.findValue(3000.f) == nullptr);
+    CHECK(view.keys()[999] == 2997.f);
+
+    int visited = 0;
+    view.visitInOrder([&](const float & key, const int & value) {
+        CHECK(key == float(value * 3));
+        ++visited;
+    });
+    CHECK(visited == 1000);
+
+    // The mapping stays valid after the file is replaced
+    CursedArray<int> other;
+    other[1.f] = 1;
+    CHECK(other.save(path));
+    CHECK(view[300.f] == 100);
+
+    view.close();
+    CHECK(!view.isOpen() and view.size() == 0);
+    std::remove(path.c_str());
+}
+
+
+/**
+ * A shifted or scaled array saves its current indexes, each once and in order, so
+ * load() and the mapped view take the file.
+ */
+void testShiftedRoundTrip() {
+    std::string path = scratchPath("shifted");
+
+    // Fractional indexes shifted far enough to round, merging some
+    CursedArray<int> array;
+    for (int i = 0; i < 1000; ++i)
+        array[float(i) * 0.1f] = i;
+    array += 1e7f;
+    CHECK(array.scaleIndexes(1.5));
+    CHECK(array.size() < 1000);
+
+    CHECK(array.save(path));
+    CursedArray<int> loaded;
+    CHECK(loaded.load(path));
+    CHECK(loaded.size() == array.size());
+
+    MappedCursedArray<int> view;
+    CHECK(view.open(path));
+    for (auto it = array.begin(), copy = loaded.begin(); it != array.end(); ++it, ++copy) {
+        CHECK(copy.key() == it.key() and *copy == *it);
+        CHECK(view.findValue(it.key()) and *view.findValue(it.key()) == *it);
+    }
+    view.close();
+
+    // Whole-number indexes shifted lazily
+    CursedArray<int> lazy;
+    for (int i = 0; i < 1000; ++i)
+        lazy[float(i)] = i;
+    lazy += 0.5f;
+    CHECK(lazy.keyOffset() == 0.5);
+    CHECK(lazy.save(path));
+    CHECK(loaded.load(path));
+    CHECK(loaded.size() == 1000 and loaded[0.5f] == 0 and loaded[999.5f] == 999);
+    std::remove(path.c_str());
+}
+
+
+/**
+ * Missing, truncated, and mismatched files are refused and leave the array as it was.
+ */
+void testRejectsBadFiles() {
+    std::string path = scratchPath("bad");
+    CursedArray<int> array;
+    array[1.f] = 1;
+    MappedCursedArray<int> view;
+
+    CHECK(!array.load(scratchPath("missing")));
+    CHECK(!view.open(scratchPath("missing")));
+
+    // Wrong value size
+    CursedArray<double> doubles;
+    doubles[1.f] = 1.0;
+    CHECK(doubles.save(path));
+    CHECK(!array.load(path));
+    CHECK(!view.open(path));
+    CHECK(array.size() == 1);
+
+    // Truncated file
+    CursedArray<int> big;
+    for (int i = 0; i < 100; ++i)
+        big[float(i)] = i;
+    CHECK(big.save(path));
+    CHECK(::truncate(path.c_str(), 200) == 0);
+    CHECK(!array.load(path));
+    CHECK(!view.open(path));
+
+    // Not a snapshot at all
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("definitely not a snapshot, but long enough to hold a header of some kind......", file);
+    std::fclose(file);
+    CHECK(!array.load(path));
+    CHECK(array.size() == 1 and array[1.f] == 1);
+
+    // No temporary file is left behind by a successful save
+    CHECK(big.save(path));
+    CHECK(::access((path + ".tmp").c_str(), F_OK) != 0);
+    std::remove(path.c_str());
+}
+
+
+int main() {
+    testRoundTrip();
+    testMappedView();
+    testShiftedRoundTrip();
+    testRejectsBadFiles();
+    return testResult();
+}
@@ -0,0 +1,97 @@
+//   File: stats_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: Operation counters and latency histograms of a CURSED_ARRAY_STATS build.
+// ---------------------------------------------------------------------
+
+#define CURSED_ARRAY_STATS
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <sstream>
+#include <string>
+
+/**
+ * Samples land in the power-of-two bucket holding them.
+ */
+void testHistogram() {
+    LatencyHistogram histogram;
+    CHECK(histogram.count() == 0 and histogram.meanNanoseconds() == 0.0);
+
+    histogram.record(0);
+    histogram.record(1);
+    histogram.record(3);
+    histogram.record(1000);
+    CHECK(histogram.count() == 4);
+    CHECK(histogram.bucketCount(0) == 2);
+    CHECK(histogram.bucketCount(1) == 1);
+    CHECK(histogram.bucketCount(9) == 1);       // 512 <= 1000 < 1024
+    CHECK(histogram.meanNanoseconds() == 251.0);
+    CHECK(histogram.percentileNanoseconds(0.5) == 4);
+    CHECK(histogram.percentileNanoseconds(0.99) == 1024);
+
+    histogram.record(~uint64_t(0));
+    CHECK(histogram.bucketCount(LatencyHistogram::BUCKETS - 1) == 1);
+}
+
+
+/**
+ * The tree counts lookups, inserts, removes, and the comparisons they needed.
+ */
+void testTreeCounters() {
+    RedBlackTree<int, int> tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i, i);
+    tree.insert(5, 50);     // Overwrite, not a new key
+
+    const TreeStats & stats = tree.stats();
+    CHECK(stats.inserts.load() == 1000);
+    CHECK(stats.rotations.load() > 0);
+    CHECK(stats.recolorings.load() > 0);
+
+    uint64_t lookupsBefore = stats.lookups.load();
+    uint64_t comparisonsBefore = stats.comparisons.load();
+    for (int i = 0; i < 100; ++i)
+        tree.findValue(i);
+    CHECK(stats.lookups.load() == lookupsBefore + 100);
+    // Each lookup compares at most one key per level
+    uint64_t comparisons = stats.comparisons.load() - comparisonsBefore;
+    CHECK(comparisons >= 100 and comparisons <= 100 * uint64_t(tree.shape().height));
+
+    CHECK(tree.remove(3));
+    CHECK(!tree.remove(3));
+    CHECK(stats.removes.load() == 1);
+    CHECK(tree.shape().nodeCount == 999);
+}
+
+
+/**
+ * operator[] reads and writes are timed, and reportStats() names every counter.
+ */
+void testArrayReport() {
+    CursedArray<int> array;
+    for (int i = 0; i < 200; ++i)
+        array[float(i)] = i;
+    int sum = 0;
+    for (int i = 0; i < 50; ++i)
+        sum += array[float(i)];
+
+    CHECK(sum == 1225);
+    CHECK(array.writeLatency().count() == 200);
+    CHECK(array.readLatency().count() == 50);
+
+    std::ostringstream out;
+    array.reportStats(out);
+    std::string report = out.str();
+    for (const char* name : {"read_count 50", "write_count 200", "read_p99_ns", "lookups",
+                             "inserts 200", "rotations_per_write", "height", "node_count 200", "bytes_used"})
+        CHECK(report.find(name) != std::string::npos);
+}
+
+
+int main() {
+    testHistogram();
+    testTreeCounters();
+    testArrayReport();
+    return testResult();
+}
@@ -0,0 +1,93 @@
+//   File: unrolled_list_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: UnrolledList positional operations checked against a std::vector.
+// ---------------------------------------------------------------------
+
+#include "../Unrolled_List.h"
+#include "Test_Check.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @return Returns true if the list holds exactly the model's values, in order.
+ */
+template <typename T>
+bool matches(UnrolledList<T> & list, const std::vector<T> & model) {
+    if (list.size() != int(model.size()))
+        return false;
+
+    size_t i = 0;
+    for (auto it = list.begin(); it != list.end(); ++it, ++i) {
+        if (i == model.size() or *it != model[i])
+            return false;
+    }
+    return i == model.size();
+}
+
+
+/**
+ * Random inserts and removes at every position, growing past and shrinking below
+ * the sizes where chunks are re-cut.
+ */
+void testAgainstVector() {
+    UnrolledList<int> list;
+    std::vector<int> model;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 20000; ++step) {
+        bool grow = (step < 12000) ? (rng() % 4 != 0) : (rng() % 4 == 0);
+        if (grow or model.empty()) {
+            int index = int(rng() % (model.size() + 1));
+            CHECK(list.insert(step, index));
+            model.insert(model.begin() + index, step);
+        }
+        else {
+            int index = int(rng() % model.size());
+            CHECK(list.remove(index) == model[index]);
+            model.erase(model.begin() + index);
+        }
+
+        if (step % 1000 == 0)
+            CHECK(matches(list, model));
+    }
+    CHECK(matches(list, model));
+
+    for (int i = 0; i < int(model.size()); i += 13)
+        CHECK(list.valueAt(i) == model[i]);
+}
+
+
+/**
+ * Out-of-range inserts are refused; lookups and makeEmpty() behave at the edges.
+ */
+void testEdges() {
+    UnrolledList<std::string> list;
+    CHECK(list.begin() == list.end());
+    CHECK(!list.insert("x", 1));
+    CHECK(!list.insert("x", -1));
+    CHECK(list.insert("b", 0));
+    CHECK(list.insert("a", 0));
+    CHECK(list.insert("c", 2));
+    CHECK(!list.insert("x", 4));
+
+    CHECK(list.findIndex("c") == 2);
+    CHECK(list.findIndex("z") == -1);
+    list.valueAt(1) = "B";
+    CHECK(matches(list, std::vector<std::string>{"a", "B", "c"}));
+
+    list.makeEmpty();
+    CHECK(list.size() == 0);
+    CHECK(list.begin() == list.end());
+    CHECK(list.insert("again", 0));
+    CHECK(list.size() == 1 and list.valueAt(0) == "again");
+}
+
+
+int main() {
+    testAgainstVector();
+    testEdges();
+    return testResult();
+}
@@ -0,0 +1,184 @@
+//   File: value_index_test.cpp
+//   Date: October 16, 2026
+// Author: David West
+//   Desc: findKey()/findKeys() with and without a HashValueIndex, and CursedArray::findByValue().
+// ---------------------------------------------------------------------
+
+#include "../CursedArray.cpp"
+#include "Test_Check.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+/**
+ * Checks findKeys() and findKey() for one value against the model.
+ */
+template <typename Tree>
+void checkLookups(Tree & tree, std::map<int, int> & model, int value) {
+    std::vector<int> expected;
+    for (const auto & pair : model) {
+        if (pair.second == value)
+            expected.push_back(pair.first);
+    }
+
+    CHECK(tree.findKeys(value) == expected);
+    const int* key = tree.findKey(value);
+    CHECK((key != nullptr) == !expected.empty());
+    if (key)
+        CHECK(model[*key] == value);
+}
+
+
+/**
+ * Every way of writing a value keeps the index right, including writes through
+ * cursedInsert() references and bulk loads.
+ */
+void testAgainstMap() {
+    std::mt19937 rng(3);
+
+    for (int round = 0; round < 20; ++round) {
+        ValueIndexedTree<int, int> tree;
+        RedBlackTree<int, int> plain;
+        std::map<int, int> model;
+
+        for (int step = 0; step < 3000; ++step) {
+            int choice = int(rng() % 10);
+            int key = int(rng() % 300);
+            int value = int(rng() % 40);
+
+            if (choice < 3) {
+                tree.insert(key, value);
+                plain.insert(key, value);
+                model[key] = value;
+            }
+            else if (choice < 5) {
+                bool removed = tree.remove(key);
+                plain.remove(key);
+                CHECK(removed == (model.erase(key) == 1));
+            }
+            else if (choice < 7) {
+                tree.cursedInsert(key) = value;
+                plain.cursedInsert(key) = value;
+                model[key] = value;
+            }
+            else if (choice < 8) {
+                tree.try_emplace(key, value);
+                plain.try_emplace(key, value);
+                model.emplace(key, value);
+            }
+            else {
+                checkLookups(tree, model, value);
+                checkLookups(plain, model, value);
+            }
+        }
+
+        if (round % 5 == 0) {
+            std::vector<int> keys;
+            std::vector<int> values;
+            for (const auto & pair : model) {
+                keys.push_back(pair.first);
+                values.push_back(pair.second);
+            }
+            tree.assignSorted(keys.begin(), keys.end(), values.begin());
+            for (int value = 0; value < 40; ++value)
+                checkLookups(tree, model, value);
+        }
+
+        CHECK(tree.valueIndexBytes() > 0 and plain.valueIndexBytes() == 0);
+    }
+}
+
+
+/**
+ * Re-indexing keys that share one value costs O(1) each, not a scan of the others.
+ */
+void testManyKeysPerValue() {
+    const int keyCount = 100000;
+    ValueIndexedTree<int, int> tree;
+    for (int i = 0; i < keyCount; ++i)
+        tree.insert(i, 0);
+    CHECK(tree.findKeys(0).size() == size_t(keyCount));
+
+    // Quadratic if each erase walks every key holding 0
+    for (int i = 0; i < keyCount; ++i)
+        tree.insert(i, 1 + i % 2);
+    CHECK(tree.findKey(0) == nullptr);
+    CHECK(tree.findKeys(1).size() == size_t(keyCount / 2));
+
+    for (int i = 0; i < keyCount; i += 2)
+        tree.remove(i);
+    CHECK(tree.findKey(1) == nullptr);
+    CHECK(tree.findKeys(2).size() == size_t(keyCount / 2));
+
+    HashValueIndex<int, int> index;
+    index.add(7, 1);
+    index.add(7, 1);
+    index.add(7, 2);
+    CHECK(index.size() == 2);
+    index.erase(7, 1);
+    index.erase(8, 2);
+    CHECK(index.size() == 1 and *index.find(7) == 2);
+    index.erase(7, 2);
+    CHECK(index.size() == 0 and index.find(7) == nullptr);
+}
+
+
+/**
+ * Writes through cursedInsert() with no lookups in between keep the stale queue bounded.
+ */
+void testStaleQueueIsBounded() {
+    ValueIndexedTree<int, int> tree;
+    for (int i = 0; i < 10; ++i)
+        tree.insert(i, i);
+    std::size_t bytesBefore = tree.valueIndexBytes();
+
+    for (int i = 0; i < 200000; ++i)
+        tree.cursedInsert(i % 10) = i;
+    CHECK(tree.valueIndexBytes() < bytesBefore + 4096);
+
+    // Still exact once looked up
+    for (int key = 0; key < 10; ++key) {
+        const int* found = tree.findKey(199990 + key);
+        CHECK(found and *found == key);
+    }
+    CHECK(tree.findKey(5) == nullptr);
+}
+
+
+/**
+ * CursedArray maps found keys back to indexes, through shifts and freezing.
+ */
+void testCursedArray() {
+    CursedArray<int, ValueIndexedTree> array;
+    for (int i = 0; i < 50; ++i)
+        array[float(i) / 2.f] = i % 7;
+
+    float index = 0.f;
+    CHECK(array.findByValue(3, index) and array[index] == 3);
+    CHECK(!array.findByValue(99, index));
+
+    std::vector<float> indexes = array.findIndexes(0);
+    CHECK(indexes.size() == 8 and indexes[1] == 3.5f);
+
+    array.shiftIndexes(10.f);
+    CHECK(array.findIndexes(0)[1] == 13.5f);
+    array.freeze();
+    CHECK(array.findIndexes(0)[1] == 13.5f);
+    CHECK(array.findByValue(0, index) and index == 10.f);
+
+    // Without an index, the scan finds the smallest index
+    CursedArray<int> plain;
+    plain[2.f] = 5;
+    plain[1.f] = 5;
+    CHECK(plain.findByValue(5, index) and index == 1.f);
+}
+
+
+int main() {
+    testAgainstMap();
+    testManyKeysPerValue();
+    testStaleQueueIsBounded();
+    testCursedArray();
+    return testResult();
+}